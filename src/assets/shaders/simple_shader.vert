@@ -1,16 +1,23 @@
 #version 450
 
-layout(location = 0) in vec3 inPosition;
-layout(location = 1) in vec3 inNormal;
-layout(location = 2) in vec3 inColor;
+layout(location = 0) in vec3 inPosition; // Half floats
+layout(location = 1) in vec2 inNormal;   // Octahedral-encoded, snorm16
+
+// Per instance
+layout(location = 2) in vec3 instancePosition;
+layout(location = 3) in vec3 instanceScale;
+layout(location = 4) in vec3 instanceColor;
 
 layout(location = 0) out vec3 fragColor;
 
-layout(push_constant) uniform PushConstants {
-	mat4 renderMatrix;
-} pushConstants;
+// Matches FrameUniformData
+layout(std140, set = 0, binding = 0) uniform FrameUniforms {
+	mat4 projectionView;
+	vec4 frustumPlanes[6];
+} frame;
 
 void main() {
-	gl_Position = pushConstants.renderMatrix * vec4(inPosition, 1.0);
-	fragColor = inColor;
+	vec3 worldPosition = inPosition * instanceScale + instancePosition;
+	gl_Position = frame.projectionView * vec4(worldPosition, 1.0);
+	fragColor = instanceColor;
 }
@@ -0,0 +1,112 @@
+// Enemy-enemy separation benchmark: brute force O(n^2) vs sort-and-sweep.
+// Mirrors the follower update in Simulation: every follower proposes a small step
+// toward the player and only moves if no other enemy is closer than 0.8.
+#include "core/SweepAndPrune.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr float SEPARATION = 0.8f;
+    constexpr float STEP = 0.02f;
+    constexpr int TICKS = 60;
+
+    struct Crowd {
+        std::vector<float> x;
+        std::vector<float> z;
+    };
+
+    Crowd makeCrowd(size_t count) {
+        // Roughly one enemy per 4 cells, like a dense generated map
+        float side = std::sqrt(static_cast<float>(count) * 4.0f);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(0.0f, side);
+        Crowd crowd;
+        for (size_t i = 0; i < count; i++) {
+            crowd.x.push_back(dist(rng));
+            crowd.z.push_back(dist(rng));
+        }
+        return crowd;
+    }
+
+    bool blocked(const Crowd& crowd, size_t self, float nx, float nz, size_t other) {
+        if (other == self) return false;
+        float dx = nx - crowd.x[other];
+        float dz = nz - crowd.z[other];
+        return std::sqrt(dx * dx + dz * dz) < SEPARATION;
+    }
+
+    template <typename Check, typename OnMove>
+    size_t tick(Crowd& crowd, float targetX, float targetZ, Check&& isBlocked, OnMove&& onMove) {
+        size_t moved = 0;
+        for (size_t i = 0; i < crowd.x.size(); i++) {
+            float dx = targetX - crowd.x[i];
+            float dz = targetZ - crowd.z[i];
+            float length = std::sqrt(dx * dx + dz * dz);
+            if (length <= 0.1f) continue;
+            float nx = crowd.x[i] + dx / length * STEP;
+            float nz = crowd.z[i] + dz / length * STEP;
+            if (isBlocked(i, nx, nz)) continue;
+            crowd.x[i] = nx;
+            crowd.z[i] = nz;
+            onMove(i, nx);
+            moved++;
+        }
+        return moved;
+    }
+
+    double msPerTick(std::chrono::steady_clock::time_point start) {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / TICKS;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t maxCount = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 16000;
+
+    std::printf("%8s %14s %14s %9s %s\n", "enemies", "brute ms/tick", "sweep ms/tick", "speedup", "match");
+    for (size_t count = 250; count <= maxCount; count *= 2) {
+        Crowd brute = makeCrowd(count);
+        Crowd sweep = brute;
+        float side = std::sqrt(static_cast<float>(count) * 4.0f);
+        float targetX = side * 0.5f;
+        float targetZ = side * 0.5f;
+
+        auto start = std::chrono::steady_clock::now();
+        size_t bruteMoves = 0;
+        for (int t = 0; t < TICKS; t++) {
+            bruteMoves += tick(brute, targetX, targetZ,
+                [&](size_t i, float nx, float nz) {
+                    for (size_t j = 0; j < brute.x.size(); j++) {
+                        if (blocked(brute, i, nx, nz, j)) return true;
+                    }
+                    return false;
+                },
+                [](size_t, float) {});
+        }
+        double bruteMs = msPerTick(start);
+
+        start = std::chrono::steady_clock::now();
+        SweepAndPrune broadphase;
+        broadphase.reset(sweep.x.data(), sweep.x.size());
+        size_t sweepMoves = 0;
+        for (int t = 0; t < TICKS; t++) {
+            sweepMoves += tick(sweep, targetX, targetZ,
+                [&](size_t i, float nx, float nz) {
+                    return broadphase.anyWithin(static_cast<uint32_t>(i), nx, SEPARATION, [&](uint32_t j) {
+                        return blocked(sweep, i, nx, nz, j);
+                    });
+                },
+                [&](size_t i, float nx) { broadphase.update(static_cast<uint32_t>(i), nx); });
+        }
+        double sweepMs = msPerTick(start);
+
+        std::printf("%8zu %14.3f %14.3f %8.1fx %s\n", count, bruteMs, sweepMs,
+                    sweepMs > 0.0 ? bruteMs / sweepMs : 0.0,
+                    bruteMoves == sweepMoves && brute.x == sweep.x ? "yes" : "NO");
+    }
+    return EXIT_SUCCESS;
+}
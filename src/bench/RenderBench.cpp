@@ -0,0 +1,195 @@
+// Offscreen render benchmark: drives the Engine without a window (works on lavapipe),
+// orbiting the camera around the player on a fixed path while the simulation runs at
+// a fixed tick, and reports frames per second, the GPU profiler regions and GPU memory per heap.
+// The last frame can be written as a PPM and compared against a golden image.
+//
+// Usage: RenderBench [--frames N] [--width w] [--height h] [--level i] [--culling cpu|gpu]
+//                    [--ppm out.ppm] [--golden ref.ppm] [--tolerance t] [--vma-stats out.json]
+#include "core/Engine.h"
+#include "renderer/GpuProfiler.h"
+#include "renderer/MemoryBudget.h"
+#include "assets/levels/AllLevels.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr float DT = 1.0f / 60.0f;
+    constexpr float YAW_PER_FRAME = 0.75f; // Degrees; one full orbit every 480 frames
+    constexpr float PITCH = 25.0f;
+    constexpr int WARMUP_FRAMES = 10; // Pipeline, culling and recording caches settle
+
+    bool writePpm(const std::string& path, const std::vector<uint8_t>& rgba, int width, int height) {
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open()) return false;
+        out << "P6\n" << width << " " << height << "\n255\n";
+        for (size_t i = 0; i < rgba.size(); i += 4) {
+            out.write(reinterpret_cast<const char*>(&rgba[i]), 3);
+        }
+        return out.good();
+    }
+
+    // Only reads what writePpm produces (binary P6, 8 bits, no comments)
+    bool readPpm(const std::string& path, std::vector<uint8_t>& rgb, int& width, int& height) {
+        std::ifstream in(path, std::ios::binary);
+        std::string magic;
+        int maxValue = 0;
+        if (!(in >> magic >> width >> height >> maxValue) || magic != "P6" || maxValue != 255) return false;
+        in.get(); // Single whitespace before the pixels
+        rgb.resize(static_cast<size_t>(width) * height * 3);
+        in.read(reinterpret_cast<char*>(rgb.data()), static_cast<std::streamsize>(rgb.size()));
+        return in.good();
+    }
+
+    // Mean absolute difference per channel, 0..255. Tolerates driver rasterization
+    // differences (lavapipe vs hardware) while catching missing or moved geometry.
+    double compareToGolden(const std::vector<uint8_t>& rgba, const std::vector<uint8_t>& goldenRgb) {
+        double total = 0.0;
+        size_t pixels = goldenRgb.size() / 3;
+        for (size_t p = 0; p < pixels; p++) {
+            for (size_t c = 0; c < 3; c++) {
+                total += std::abs(static_cast<int>(rgba[p * 4 + c]) - static_cast<int>(goldenRgb[p * 3 + c]));
+            }
+        }
+        return pixels > 0 ? total / (pixels * 3) : 0.0;
+    }
+}
+
+int main(int argc, char** argv) {
+    int frameCount = 600;
+    int level = 0;
+    double tolerance = 2.0;
+    std::string ppmPath;
+    std::string goldenPath;
+    std::string statsPath;
+    EngineConfig config;
+    config.offscreen = true;
+    config.gpuProfileLogInterval = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) frameCount = std::atoi(argv[++i]);
+        else if (arg == "--width" && hasValue) config.width = std::atoi(argv[++i]);
+        else if (arg == "--height" && hasValue) config.height = std::atoi(argv[++i]);
+        else if (arg == "--level" && hasValue) level = std::atoi(argv[++i]);
+        else if (arg == "--culling" && hasValue) {
+            std::string mode = argv[++i];
+            if (mode == "cpu") config.culling = CullingMode::CPU;
+            else if (mode == "gpu") config.culling = CullingMode::GPU;
+            else {
+                std::cerr << "Modo de culling invalido: " << mode << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+        else if (arg == "--ppm" && hasValue) ppmPath = argv[++i];
+        else if (arg == "--golden" && hasValue) goldenPath = argv[++i];
+        else if (arg == "--tolerance" && hasValue) tolerance = std::strtod(argv[++i], nullptr);
+        else if (arg == "--vma-stats" && hasValue) statsPath = argv[++i];
+        else {
+            std::cerr << "Uso: " << argv[0] << " [--frames N] [--width w] [--height h] [--level i] [--culling cpu|gpu]"
+                      << " [--ppm saida.ppm] [--golden referencia.ppm] [--tolerance t] [--vma-stats saida.json]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (frameCount <= 0 || config.width <= 0 || config.height <= 0) {
+        std::cerr << "Numero de frames ou resolucao invalidos\n";
+        return EXIT_FAILURE;
+    }
+    if (level < 0 || level >= static_cast<int>(Assets::ALL_LEVELS.size())) {
+        std::cerr << "Fase invalida: " << level << " (existem " << Assets::ALL_LEVELS.size() << ")\n";
+        return EXIT_FAILURE;
+    }
+
+    Engine engine(config);
+    std::vector<uint8_t> frame;
+    double seconds = 0.0;
+    try {
+        engine.init();
+        engine.getSimulation().loadLevel(level);
+
+        // loadLevel starts the level in PLAYING. The player stands still while the camera
+        // orbits; followers still chase it, so the run is only comparable if it ends in
+        // that same level and state (checked below).
+        SimulationInput input{};
+        std::chrono::steady_clock::time_point start;
+        for (int f = 0; f < WARMUP_FRAMES + frameCount; f++) {
+            if (f == WARMUP_FRAMES) start = std::chrono::steady_clock::now();
+            float yaw = std::fmod(f * YAW_PER_FRAME, 360.0f);
+            engine.setCameraAngles(yaw, PITCH);
+            input.cameraYaw = yaw;
+            engine.step(input, DT);
+        }
+
+        // Reading back waits for the GPU, so the time includes every submitted frame
+        engine.readLastFrame(frame);
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        engine.cleanup();
+        return EXIT_FAILURE;
+    }
+
+    // GAME_OVER, VICTORY or a level change alter the clear color and the geometry,
+    // so neither the timing nor the golden image would describe the intended scene
+    const Simulation& simulation = engine.getSimulation();
+    if (simulation.getState() != GameState::PLAYING || simulation.getLevelIndex() != level) {
+        std::cerr << "A cena mudou durante o benchmark (fim de jogo ou troca de fase); resultado descartado\n";
+        engine.cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::printf("resolution: %dx%d, level %d, %s culling\n", config.width, config.height, level,
+                config.culling == CullingMode::GPU ? "gpu" : "cpu");
+    std::printf("frames:     %d in %.3f s (%.1f fps, %.3f ms/frame)\n", frameCount, seconds,
+                seconds > 0.0 ? frameCount / seconds : 0.0, frameCount > 0 ? seconds * 1000.0 / frameCount : 0.0);
+    const GpuProfiler* profiler = engine.getGpuProfiler();
+    if (profiler && profiler->isSupported()) {
+        std::printf("GPU ms (min/avg/max): %s\n", profiler->formatStats().c_str());
+    }
+    std::printf("memory:     %s\n", engine.getMemoryBudget()->formatHeapUsage().c_str());
+
+    int status = EXIT_SUCCESS;
+    if (!statsPath.empty()) {
+        if (engine.dumpMemoryStats(statsPath)) std::printf("vma stats:  %s\n", statsPath.c_str());
+        else status = EXIT_FAILURE;
+    }
+    if (!ppmPath.empty()) {
+        if (writePpm(ppmPath, frame, config.width, config.height)) {
+            std::printf("image:      %s\n", ppmPath.c_str());
+        } else {
+            std::cerr << "Falha ao gravar imagem: " << ppmPath << "\n";
+            status = EXIT_FAILURE;
+        }
+    }
+
+    if (!goldenPath.empty()) {
+        std::vector<uint8_t> golden;
+        int goldenWidth = 0;
+        int goldenHeight = 0;
+        if (!readPpm(goldenPath, golden, goldenWidth, goldenHeight)) {
+            std::cerr << "Falha ao ler imagem de referencia: " << goldenPath << "\n";
+            status = EXIT_FAILURE;
+        } else if (goldenWidth != config.width || goldenHeight != config.height) {
+            std::cerr << "Resolucao da referencia (" << goldenWidth << "x" << goldenHeight << ") difere da renderizada\n";
+            status = EXIT_FAILURE;
+        } else {
+            double difference = compareToGolden(frame, golden);
+            bool match = difference <= tolerance;
+            std::printf("golden:     %s, mean difference %.3f (tolerance %.3f) %s\n", goldenPath.c_str(), difference,
+                        tolerance, match ? "OK" : "FALHOU");
+            if (!match) status = EXIT_FAILURE;
+        }
+    }
+
+    engine.cleanup();
+    return status;
+}
@@ -0,0 +1,150 @@
+#include "EnemyPool.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENEMY_POOL_SSE2 1
+#endif
+
+namespace {
+    constexpr float MIN_STEER_DISTANCE = 0.1f;
+}
+
+void EnemyPool::reset(const std::vector<glm::vec3>& staticPositions, const std::vector<glm::vec3>& followerPositions) {
+    for (auto* array : {&x, &y, &z, &prevX, &prevY, &prevZ, &minX, &minY, &minZ, &maxX, &maxY, &maxZ}) {
+        array->clear();
+        array->reserve(staticPositions.size() + followerPositions.size());
+    }
+
+    for (const auto& position : staticPositions) push(position);
+    followerBegin = x.size();
+    for (const auto& position : followerPositions) push(position);
+}
+
+void EnemyPool::push(const glm::vec3& position) {
+    x.push_back(position.x);
+    y.push_back(position.y);
+    z.push_back(position.z);
+    prevX.push_back(position.x);
+    prevY.push_back(position.y);
+    prevZ.push_back(position.z);
+    minX.push_back(position.x - HALF_EXTENT);
+    minY.push_back(position.y - HALF_EXTENT);
+    minZ.push_back(position.z - HALF_EXTENT);
+    maxX.push_back(position.x + HALF_EXTENT);
+    maxY.push_back(position.y + HALF_EXTENT);
+    maxZ.push_back(position.z + HALF_EXTENT);
+}
+
+void EnemyPool::setPosition(size_t i, const glm::vec3& position) {
+    x[i] = position.x;
+    y[i] = position.y;
+    z[i] = position.z;
+    minX[i] = position.x - HALF_EXTENT;
+    minY[i] = position.y - HALF_EXTENT;
+    minZ[i] = position.z - HALF_EXTENT;
+    maxX[i] = position.x + HALF_EXTENT;
+    maxY[i] = position.y + HALF_EXTENT;
+    maxZ[i] = position.z + HALF_EXTENT;
+}
+
+void EnemyPool::savePreviousPositions() {
+    if (x.empty()) return;
+    std::memcpy(prevX.data(), x.data(), x.size() * sizeof(float));
+    std::memcpy(prevY.data(), y.data(), y.size() * sizeof(float));
+    std::memcpy(prevZ.data(), z.data(), z.size() * sizeof(float));
+}
+
+void EnemyPool::steerFollowers(size_t first, size_t count, const glm::vec3& target, float step, const uint8_t* visible,
+                               float* outX, float* outZ, uint8_t* moving) const {
+    const float* fx = x.data() + followerBegin + first;
+    const float* fz = z.data() + followerBegin + first;
+    visible += first;
+    outX += first;
+    outZ += first;
+    moving += first;
+    size_t k = 0;
+
+#ifdef ENEMY_POOL_SSE2
+    const __m128 targetX = _mm_set1_ps(target.x);
+    const __m128 targetZ = _mm_set1_ps(target.z);
+    const __m128 stepV = _mm_set1_ps(step);
+    const __m128 minDistance = _mm_set1_ps(MIN_STEER_DISTANCE);
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; k + 4 <= count; k += 4) {
+        __m128 px = _mm_loadu_ps(fx + k);
+        __m128 pz = _mm_loadu_ps(fz + k);
+        __m128 dx = _mm_sub_ps(targetX, px);
+        __m128 dz = _mm_sub_ps(targetZ, pz);
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz)));
+
+        // Widen 4 visibility bytes into a lane mask
+        int visibleBytes;
+        std::memcpy(&visibleBytes, visible + k, sizeof(visibleBytes));
+        __m128i lanes = _mm_cvtsi32_si128(visibleBytes);
+        lanes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(lanes, zero), zero);
+        __m128 visibleMask = _mm_castsi128_ps(_mm_cmpgt_epi32(lanes, zero));
+
+        __m128 mask = _mm_and_ps(visibleMask, _mm_cmpgt_ps(length, minDistance));
+        __m128 scale = _mm_div_ps(stepV, _mm_max_ps(length, minDistance));
+
+        _mm_storeu_ps(outX + k, _mm_add_ps(px, _mm_and_ps(mask, _mm_mul_ps(dx, scale))));
+        _mm_storeu_ps(outZ + k, _mm_add_ps(pz, _mm_and_ps(mask, _mm_mul_ps(dz, scale))));
+
+        int bits = _mm_movemask_ps(mask);
+        moving[k + 0] = static_cast<uint8_t>(bits & 1);
+        moving[k + 1] = static_cast<uint8_t>((bits >> 1) & 1);
+        moving[k + 2] = static_cast<uint8_t>((bits >> 2) & 1);
+        moving[k + 3] = static_cast<uint8_t>((bits >> 3) & 1);
+    }
+#endif
+
+    for (; k < count; k++) {
+        float dx = target.x - fx[k];
+        float dz = target.z - fz[k];
+        float length = std::sqrt(dx * dx + dz * dz);
+        bool move = visible[k] != 0 && length > MIN_STEER_DISTANCE;
+        float scale = move ? step / length : 0.0f;
+        outX[k] = fx[k] + dx * scale;
+        outZ[k] = fz[k] + dz * scale;
+        moving[k] = move ? 1 : 0;
+    }
+}
+
+void EnemyPool::overlapping(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& hits) const {
+    size_t count = x.size();
+    size_t i = 0;
+
+#ifdef ENEMY_POOL_SSE2
+    const __m128 bMinX = _mm_set1_ps(boxMin.x), bMaxX = _mm_set1_ps(boxMax.x);
+    const __m128 bMinY = _mm_set1_ps(boxMin.y), bMaxY = _mm_set1_ps(boxMax.y);
+    const __m128 bMinZ = _mm_set1_ps(boxMin.z), bMaxZ = _mm_set1_ps(boxMax.z);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 overlapX = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX.data() + i), bMaxX),
+                                     _mm_cmpge_ps(_mm_loadu_ps(maxX.data() + i), bMinX));
+        __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY.data() + i), bMaxY),
+                                     _mm_cmpge_ps(_mm_loadu_ps(maxY.data() + i), bMinY));
+        __m128 overlapZ = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minZ.data() + i), bMaxZ),
+                                     _mm_cmpge_ps(_mm_loadu_ps(maxZ.data() + i), bMinZ));
+        int bits = _mm_movemask_ps(_mm_and_ps(overlapX, _mm_and_ps(overlapY, overlapZ)));
+        // Common case: no hits in this group of four
+        while (bits != 0) {
+            int lane = 0;
+            while (((bits >> lane) & 1) == 0) lane++;
+            hits.push_back(static_cast<uint32_t>(i + lane));
+            bits &= bits - 1;
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (minX[i] <= boxMax.x && maxX[i] >= boxMin.x &&
+            minY[i] <= boxMax.y && maxY[i] >= boxMin.y &&
+            minZ[i] <= boxMax.z && maxZ[i] >= boxMin.z) {
+            hits.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Enemies stored as parallel arrays (structure of arrays) so the per-tick
+// kernels stream through contiguous floats instead of branching per enemy.
+// Static 'X' enemies occupy [0, followerBegin), followers 'F' occupy [followerBegin, size()).
+class EnemyPool {
+public:
+    static constexpr float HALF_EXTENT = 0.5f; // Enemies are 1x1x1 boxes
+
+    void reset(const std::vector<glm::vec3>& staticPositions, const std::vector<glm::vec3>& followerPositions);
+
+    size_t size() const { return x.size(); }
+    size_t getFollowerBegin() const { return followerBegin; }
+    size_t getFollowerCount() const { return x.size() - followerBegin; }
+
+    const float* getXData() const { return x.data(); }
+    glm::vec3 position(size_t i) const { return {x[i], y[i], z[i]}; }
+    glm::vec3 previousPosition(size_t i) const { return {prevX[i], prevY[i], prevZ[i]}; }
+    void setPosition(size_t i, const glm::vec3& position);
+
+    // Snapshot for render interpolation
+    void savePreviousPositions();
+
+    // Proposes the next XZ position of followers [first, first + count) (0-based within the
+    // follower range), stepping 'step' units toward target. Follower k only moves when
+    // visible[k] != 0 and it is further than 0.1 from the target; moving[k] reports that.
+    // Arrays are indexed by follower k. Y is left untouched.
+    void steerFollowers(size_t first, size_t count, const glm::vec3& target, float step, const uint8_t* visible,
+                        float* outX, float* outZ, uint8_t* moving) const;
+
+    // Appends indices of enemies whose box overlaps [boxMin, boxMax] (touching counts), in index order
+    void overlapping(const glm::vec3& boxMin, const glm::vec3& boxMax, std::vector<uint32_t>& hits) const;
+
+private:
+    void push(const glm::vec3& position);
+
+    std::vector<float> x, y, z;
+    std::vector<float> prevX, prevY, prevZ;
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+    size_t followerBegin{0};
+};
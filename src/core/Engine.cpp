@@ -2,8 +2,16 @@
 #include "Engine.h"
 #include "../renderer/VulkanContext.h"
 #include "../renderer/Swapchain.h"
+#include "../renderer/OffscreenTarget.h"
 #include "../renderer/Pipeline.h"
 #include "../renderer/Mesh.h"
+#include "../renderer/FrameArena.h"
+#include "../renderer/GpuCuller.h"
+#include "../renderer/LevelMesh.h"
+#include "../renderer/SecondaryRecorder.h"
+#include "../renderer/FrameUniforms.h"
+#include "../renderer/GpuProfiler.h"
+#include "../renderer/MemoryBudget.h"
 #include "Camera.h"
 #include <iostream>
 #include <glm/glm.hpp>
@@ -12,9 +20,37 @@
 #include <stdexcept>
 #include <fstream>
 #include <sstream>
-#include "../assets/levels/AllLevels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+
+namespace {
+    const glm::vec3 GROUND_COLOR{0.3f, 0.3f, 0.3f};
+    const glm::vec3 PLAYER_COLOR{0.0f, 0.8f, 1.0f};
+    const glm::vec3 OBSTACLE_COLOR{1.0f, 0.2f, 0.2f};
+    const glm::vec3 EXIT_COLOR{0.0f, 1.0f, 0.0f};
+    const glm::vec3 ENEMY_COLOR{1.0f, 0.0f, 1.0f};
+    const glm::vec3 FOLLOWER_COLOR{1.0f, 0.5f, 0.0f};
+
+    // Fixed head of the per-frame instance list; level sections are baked in world
+    // space, so their instances only carry a color. Visible cubes follow.
+    constexpr uint32_t GROUND_INSTANCE = 0;
+    constexpr uint32_t WALL_INSTANCE = 1;
+    constexpr uint32_t EXIT_INSTANCE = 2;
+    constexpr uint32_t FIRST_CUBE_INSTANCE = 3;
+
+    VkPresentModeKHR toVulkan(PresentMode mode) {
+        switch (mode) {
+            case PresentMode::MAILBOX: return VK_PRESENT_MODE_MAILBOX_KHR;
+            case PresentMode::IMMEDIATE: return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            case PresentMode::FIFO: break;
+        }
+        return VK_PRESENT_MODE_FIFO_KHR;
+    }
+}
 
-Engine::Engine() {
+Engine::Engine(const EngineConfig& engineConfig) : config(engineConfig), width(engineConfig.width), height(engineConfig.height) {
     vulkanContext = std::make_unique<VulkanContext>();
 }
 
@@ -25,230 +61,113 @@ Engine::~Engine() {
 
 
 void Engine::init() {
-    initWindow();
-    vulkanContext->init(window, windowTitle.c_str());
-    
-    // Swapchain init
-    swapchain = std::make_unique<Swapchain>();
-    swapchain->init(vulkanContext.get(), width, height);
-
-    createPipeline();
-    
-    camera = std::make_unique<Camera>();
-    createScene();
+    auto startTime = std::chrono::steady_clock::now();
 
-    createCommandBuffer();
+    jobSystem = std::make_unique<JobSystem>();
+    simulation = std::make_unique<Simulation>(*jobSystem);
 
-    isInitialized = true;
-}
-
-void Engine::createScene() {
-    // 1. Ground Mesh (Quad on XZ plane)
-    std::vector<Vertex> groundVertices = {
-        {{-5.0f, 0.0f, -5.0f}, {0.0f, 1.0f, 0.0f}, {0.3f, 0.3f, 0.3f}},
-        {{-5.0f, 0.0f,  5.0f}, {0.0f, 1.0f, 0.0f}, {0.3f, 0.3f, 0.3f}},
-        {{ 5.0f, 0.0f, -5.0f}, {0.0f, 1.0f, 0.0f}, {0.3f, 0.3f, 0.3f}},
-        
-        {{ 5.0f, 0.0f, -5.0f}, {0.0f, 1.0f, 0.0f}, {0.3f, 0.3f, 0.3f}},
-        {{-5.0f, 0.0f,  5.0f}, {0.0f, 1.0f, 0.0f}, {0.3f, 0.3f, 0.3f}},
-        {{ 5.0f, 0.0f,  5.0f}, {0.0f, 1.0f, 0.0f}, {0.3f, 0.3f, 0.3f}}
-    };
-    groundMesh = std::make_unique<Mesh>(vulkanContext.get(), groundVertices);
-
-    // 2. Helper for Cube
-    auto createCubeVertices = [&](glm::vec3 color) -> std::vector<Vertex> {
-        std::vector<Vertex> v;
-        auto addQuad = [&](glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec3 p4, glm::vec3 c) {
-            v.push_back({p1, {0,1,0}, c});
-            v.push_back({p2, {0,1,0}, c});
-            v.push_back({p3, {0,1,0}, c});
-            v.push_back({p3, {0,1,0}, c});
-            v.push_back({p2, {0,1,0}, c});
-            v.push_back({p4, {0,1,0}, c});
-        };
-        // Front
-        addQuad({-0.5f, -0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, color);
-        // Back
-        addQuad({0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {-0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f}, color);
-        // Left
-        addQuad({-0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f}, {-0.5f, -0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, color);
-        // Right
-        addQuad({0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, color);
-        // Top
-        addQuad({-0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, -0.5f}, color);
-        // Bottom
-        addQuad({-0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f, 0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, 0.5f}, color);
-        return v;
-    };
-
-    // Player Mesh (Cyan/Blue)
-    playerMesh = std::make_unique<Mesh>(vulkanContext.get(), createCubeVertices({0.0f, 0.8f, 1.0f}));
-
-    // Obstacle Mesh (Red)
-    obstacleMesh = std::make_unique<Mesh>(vulkanContext.get(), createCubeVertices({1.0f, 0.2f, 0.2f}));
+    if (config.offscreen) {
+        // No window: a null one makes the context headless
+        vulkanContext->init(nullptr, windowTitle.c_str());
+        offscreenTarget = std::make_unique<OffscreenTarget>(vulkanContext.get(), width, height, MAX_FRAMES_IN_FLIGHT);
+        renderTarget = offscreenTarget.get();
+    } else {
+        initWindow();
+        vulkanContext->init(window, windowTitle.c_str());
 
-    // Enemy Mesh (Magenta)
-    enemyMesh = std::make_unique<Mesh>(vulkanContext.get(), createCubeVertices({1.0f, 0.0f, 1.0f}));
+        // Swapchain init
+        swapchain = std::make_unique<Swapchain>();
+        swapchain->init(vulkanContext.get(), width, height, toVulkan(config.presentMode));
+        renderTarget = swapchain.get();
+    }
 
-    // Follower Mesh (Orange)
-    followerMesh = std::make_unique<Mesh>(vulkanContext.get(), createCubeVertices({1.0f, 0.5f, 0.0f}));
+    frameUniforms = std::make_unique<FrameUniforms>(vulkanContext.get(), MAX_FRAMES_IN_FLIGHT);
 
-    // Exit Mesh (Green)
-    exitMesh = std::make_unique<Mesh>(vulkanContext.get(), createCubeVertices({0.0f, 1.0f, 0.0f}));
+    gpuProfiler = std::make_unique<GpuProfiler>(vulkanContext.get(), MAX_FRAMES_IN_FLIGHT);
+    profileRegions.frame = gpuProfiler->addRegion("frame");
+    profileRegions.cull = gpuProfiler->addRegion("cull");
+    profileRegions.ground = gpuProfiler->addRegion("ground");
+    profileRegions.cubes = gpuProfiler->addRegion("cubes");
+    profileRegions.level = gpuProfiler->addRegion("level");
 
-    // 3. Load Level
-    loadLevel(currentLevelIndex);
-}
+    // The graphics pipeline only needs the render pass and the uniforms' layout; compile it
+    // on another thread while the scene, the level and the frame resources are set up
+    auto pipelineReady = std::async(std::launch::async, [this] { createPipeline(); });
+    
+    camera = std::make_unique<Camera>();
+    createScene();
 
-void Engine::loadLevel(int levelIndex) {
-    if (levelIndex >= Assets::ALL_LEVELS.size()) {
-        std::cout << "Parabéns! Você completou todas as fases!\n";
-        currentLevelIndex = 0; // Reset
-        levelIndex = 0;
-        currentState = GameState::VICTORY;
-        return;
+    if (config.culling == CullingMode::GPU && !vulkanContext->hasDrawIndirectFirstInstance()) {
+        std::cerr << "Dispositivo sem drawIndirectFirstInstance; usando culling na CPU\n";
+        config.culling = CullingMode::CPU;
     }
-
-    std::string levelData = Assets::ALL_LEVELS[levelIndex];
-    std::stringstream file(levelData);
-    
-    obstacles.clear();
-    exits.clear();
-    enemies.clear();
-    
-    // Reset Physics State
-    playerVelocityY = 0.0f;
-    isGrounded = false;
-    playerHealth = maxHealth;
-    playerKnockback = glm::vec3(0.0f);
-    currentState = GameState::PLAYING;
-    
-    std::string line;
-    int row = 0;
-    
-    // Grid: Z increases with rows (down), X increases with columns (right)
-    // Map center offset could be added later. For now, top-left of file is (0,0) in world?
-    // Let's center it a bit. Let's say top-left is (-10, -10) or similar.
-    // Or just start at (0,0) and let the player figure it out.
-    // Let's use (x, z) = (col, row). 1 unit per char.
-    
-    float offsetZ = -5.0f; // Center grid roughly
-    float offsetX = -10.0f;
-    
-    int maxCols = 0;
-    while (std::getline(file, line)) {
-        if (line.length() > maxCols) maxCols = line.length();
-        for (int col = 0; col < line.length(); col++) {
-            char c = line[col];
-            float x = static_cast<float>(col) + offsetX;
-            float z = static_cast<float>(row) + offsetZ;
-            
-            if (c == '#') {
-                // Obstacle (1x1x1)
-                // Position is centered at x, 0.5 (on ground), z
-                // AABB Min/Max
-                glm::vec3 min{x - 0.5f, 0.0f, z - 0.5f};
-                glm::vec3 max{x + 0.5f, 1.0f, z + 0.5f};
-                obstacles.push_back({min, max});
-            } else if (c == 'P') {
-                // Player Start
-                playerPosition = {x, 1.0f, z}; // Slightly above ground
-            } else if (c == 'E') {
-                // Exit Block
-                glm::vec3 min{x - 0.5f, 0.0f, z - 0.5f};
-                glm::vec3 max{x + 0.5f, 1.0f, z + 0.5f};
-                exits.push_back({min, max});
-            } else if (c == 'X') {
-                // Static Enemy
-                glm::vec3 pos{x, 0.5f, z};
-                AABB box{{x - 0.5f, 0.0f, z - 0.5f}, {x + 0.5f, 1.0f, z + 0.5f}};
-                enemies.push_back({box, pos, 'X'});
-            } else if (c == 'F') {
-                // Follower Enemy
-                glm::vec3 pos{x, 0.5f, z};
-                AABB box{{x - 0.5f, 0.0f, z - 0.5f}, {x + 0.5f, 1.0f, z + 0.5f}};
-                enemies.push_back({box, pos, 'F'});
-            }
-        }
-        row++;
+    if (config.culling == CullingMode::GPU) {
+        gpuCuller = std::make_unique<GpuCuller>(vulkanContext.get(), *frameUniforms, MAX_FRAMES_IN_FLIGHT);
     }
 
-    // Set Boundaries
-    minX = offsetX - 0.5f;
-    maxX = offsetX + static_cast<float>(maxCols) - 0.5f;
-    minZ = offsetZ - 0.5f;
-    maxZ = offsetZ + static_cast<float>(row) - 0.5f;
-}
+    createFrameResources();
 
-void Engine::takeDamage(float amount, const glm::vec3& sourcePos) {
-    if (currentState != GameState::PLAYING) return;
-    
-    playerHealth -= amount;
-    // std::cout << "Vida: " << playerHealth << "/" << maxHealth << "\n";
-    
-    // Apply Knockback
-    if (amount > 0.0f) {
-        glm::vec3 knockDir = playerPosition - sourcePos;
-        knockDir.y = 0.0f; // Only horizontal knockback for now
-        if (glm::length(knockDir) < 0.001f) {
-            knockDir = glm::vec3(0.0f, 0.0f, 1.0f); // Default dir
-        }
-        playerKnockback = glm::normalize(knockDir) * 0.3f;
-    }
+    pipelineReady.get(); // Rethrows if creation failed
 
-    if (playerHealth <= 0) {
-        playerHealth = 0;
-        currentState = GameState::GAME_OVER;
-        std::cout << "GAME OVER! Pressione Enter para tentar novamente.\n";
-    }
-}
+    std::chrono::duration<double, std::milli> startup = std::chrono::steady_clock::now() - startTime;
+    std::cout << "Inicializacao: " << startup.count() << " ms\n";
 
-void Engine::restartLevel() {
-    loadLevel(currentLevelIndex);
+    isInitialized = true;
 }
 
-bool Engine::hasLineOfSight(const glm::vec3& start, const glm::vec3& end) {
-    glm::vec3 dir = end - start;
-    float dist = glm::length(dir);
-    if (dist < 0.001f) return true;
-    dir = glm::normalize(dir);
-
-    // Simple raycast: check points along the line
-    int steps = static_cast<int>(dist * 2.0f); // 0.5 unit steps
-    for (int i = 1; i <= steps; i++) {
-        glm::vec3 p = start + dir * (static_cast<float>(i) * 0.5f);
-        if (p.y < 0.0f) continue; // Below ground check?
+void Engine::createScene() {
+    // 1. Ground Mesh (Quad on XZ plane)
+    glm::vec3 up{0.0f, 1.0f, 0.0f};
+    std::vector<Vertex> groundVertices = {
+        Vertex::make({-5.0f, 0.0f, -5.0f}, up),
+        Vertex::make({-5.0f, 0.0f,  5.0f}, up),
+        Vertex::make({ 5.0f, 0.0f, -5.0f}, up),
         
-        // Check against obstacles
-        for (const auto& obs : obstacles) {
-            if (p.x >= obs.min.x && p.x <= obs.max.x &&
-                p.y >= obs.min.y && p.y <= obs.max.y &&
-                p.z >= obs.min.z && p.z <= obs.max.z) {
-                return false; // Hitting a wall
-            }
+        Vertex::make({ 5.0f, 0.0f, -5.0f}, up),
+        Vertex::make({-5.0f, 0.0f,  5.0f}, up),
+        Vertex::make({ 5.0f, 0.0f,  5.0f}, up)
+    };
+    groundMesh = std::make_unique<Mesh>(vulkanContext.get(), groundVertices, "Ground");
+
+    // 2. Unit Cube, shared by the player, walls, exits and enemies; colors come per instance
+    std::vector<Vertex> cubeVertices;
+    auto addQuad = [&](glm::vec3 p1, glm::vec3 p2, glm::vec3 p3, glm::vec3 p4, glm::vec3 n) {
+        for (const auto& p : {p1, p2, p3, p3, p2, p4}) {
+            cubeVertices.push_back(Vertex::make(p, n));
         }
-    }
-    return true;
-}
+    };
+    // Front
+    addQuad({-0.5f, -0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, {0, 0, 1});
+    // Back
+    addQuad({0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {-0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f}, {0, 0, -1});
+    // Left
+    addQuad({-0.5f, -0.5f, -0.5f}, {-0.5f, 0.5f, -0.5f}, {-0.5f, -0.5f, 0.5f}, {-0.5f, 0.5f, 0.5f}, {-1, 0, 0});
+    // Right
+    addQuad({0.5f, -0.5f, 0.5f}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, -0.5f}, {1, 0, 0});
+    // Top
+    addQuad({-0.5f, 0.5f, 0.5f}, {-0.5f, 0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, -0.5f}, {0, 1, 0});
+    // Bottom
+    addQuad({-0.5f, -0.5f, -0.5f}, {-0.5f, -0.5f, 0.5f}, {0.5f, -0.5f, -0.5f}, {0.5f, -0.5f, 0.5f}, {0, -1, 0});
+    cubeMesh = std::make_unique<Mesh>(vulkanContext.get(), cubeVertices, "Cube");
 
+    // 3. Load Level
+    simulation->loadLevel(0);
+}
 
 void Engine::createPipeline() {
     PipelineConfigInfo pipelineConfig{};
     Pipeline::defaultPipelineConfigInfo(pipelineConfig);
     
-    pipelineConfig.renderPass = swapchain->getRenderPass();
+    pipelineConfig.renderPass = renderTarget->getRenderPass();
     pipelineConfig.pipelineLayout = VK_NULL_HANDLE; 
 
+    // The camera comes from the frame slot's uniform buffer (set 0)
+    VkDescriptorSetLayout frameLayout = frameUniforms->getDescriptorSetLayout();
+
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-    pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(glm::mat4); 
-    
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &frameLayout;
 
     VkPipelineLayout layout;
     if (vkCreatePipelineLayout(vulkanContext->getDevice(), &pipelineLayoutInfo, nullptr, &layout) != VK_SUCCESS) {
@@ -264,209 +183,14 @@ void Engine::createPipeline() {
     );
 }
 
-bool Engine::checkCollision(const glm::vec3& pos, const AABB& playerBox, const AABB& obstacle) {
-    // Player AABB at new position 'pos'
-    // Assuming player is 1x1x1 centered at bottom (0.5 extents)
-    // Actually player origin is center so bounds are pos +/- 0.5
-    
-    glm::vec3 pMin = pos - glm::vec3(0.5f);
-    glm::vec3 pMax = pos + glm::vec3(0.5f);
-    
-    // Check overlap
-    bool xOverlap = pMin.x <= obstacle.max.x && pMax.x >= obstacle.min.x;
-    bool yOverlap = pMin.y <= obstacle.max.y && pMax.y >= obstacle.min.y;
-    bool zOverlap = pMin.z <= obstacle.max.z && pMax.z >= obstacle.min.z;
-    
-    return xOverlap && yOverlap && zOverlap;
-}
-
-void Engine::processInput() {
-    if (currentState == GameState::MAIN_MENU) {
-        if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) {
-            currentState = GameState::PLAYING;
-            restartLevel(); // Force fresh start
-        }
-        return;
-    }
-
-    if (currentState == GameState::VICTORY) {
-        if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) {
-            currentState = GameState::MAIN_MENU;
-        }
-        return;
-    }
-
-    if (currentState == GameState::GAME_OVER) {
-        if (glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS) {
-            restartLevel();
-        }
-        return; // Don't move while game over
-    }
-
-    float speed = 0.05f; 
-    
-    float yawRad = glm::radians(cameraYaw);
-    glm::vec3 forwardDir = glm::normalize(glm::vec3(-sin(yawRad), 0.0f, -cos(yawRad)));
-    glm::vec3 rightDir   = glm::normalize(glm::vec3(cos(yawRad), 0.0f, -sin(yawRad)));
-
-    glm::vec3 moveDir{0.0f};
-
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) moveDir += forwardDir;
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) moveDir -= forwardDir;
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) moveDir -= rightDir; 
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) moveDir += rightDir; 
-
-    // PHYSICS & MOVEMENT
-    float gravity = 0.005f;
-    float jumpForce = 0.15f;
-    
-    // Apply Friction to knockback
-    if (glm::length(playerKnockback) > 0.001f) {
-        playerKnockback *= 0.92f; // Decay
-    } else {
-        playerKnockback = glm::vec3(0.0f);
-    }
-
-    // Combine player movement and knockback
-    glm::vec3 finalMove = moveDir * speed + playerKnockback;
-
-    // Apply XZ Movement
-    if (glm::length(finalMove) > 0.0f) {
-        glm::vec3 nextPos = playerPosition + finalMove;
-        nextPos.y = playerPosition.y; // Preserve Y for now
-
-        bool collided = false;
-        AABB pBox{{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}};
-        for (const auto& obs : obstacles) {
-            if (checkCollision(nextPos, pBox, obs)) {
-                collided = true;
-                break;
-            }
-        }
-        if (!collided) {
-            playerPosition.x = nextPos.x;
-            playerPosition.z = nextPos.z;
-        }
-    }
-
-    // Apply Boundaries
-    if (playerPosition.x < minX) playerPosition.x = minX;
-    if (playerPosition.x > maxX) playerPosition.x = maxX;
-    if (playerPosition.z < minZ) playerPosition.z = minZ;
-    if (playerPosition.z > maxZ) playerPosition.z = maxZ;
-
-    // Apply Gravity / Jump
-    if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS && isGrounded) {
-        playerVelocityY = jumpForce;
-        isGrounded = false;
-    }
-
-    playerVelocityY -= gravity;
-    float nextY = playerPosition.y + playerVelocityY;
-    
-    // Ground Collision (Y Plane at 0.0)
-    // Player Half-Height is 0.5. So simple ground check is y < 0.5
-    if (nextY < 0.5f) {
-        nextY = 0.5f;
-        playerVelocityY = 0.0f;
-        isGrounded = true;
-    } else {
-        isGrounded = false;
-        
-        // Simple Obstacle Collision for Y?
-        // If falling onto an obstacle...
-        AABB pBox{{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}};
-        glm::vec3 testPos = playerPosition;
-        testPos.y = nextY;
-        
-        for (const auto& obs : obstacles) {
-            if (checkCollision(testPos, pBox, obs)) {
-                // Collision detected on Y axis change
-                // Determine if landing on top or hitting head
-                if (playerVelocityY < 0.0f) {
-                    // Landing on top
-                     // Approximate: Set Y to box max + 0.5
-                     // obs.max.y + 0.5?
-                     // Let's just stop for now
-                     // But we need to distinguish Y collision from XZ collision
-                }
-                // Revert Y change (simple response)
-                nextY = playerPosition.y; 
-                playerVelocityY = 0.0f;
-                // Ideally check normal, but AABB:
-                // If we were above before...
-                 if (playerPosition.y >= obs.max.y + 0.5f - 0.01f) {
-                     nextY = obs.max.y + 0.5f + 0.001f; // Add epsilon to be cleanly "above"
-                     isGrounded = true;
-                     playerVelocityY = 0.0f; // Stop falling
-                 }
-                break;
-            }
-        }
-    }
-    
-    playerPosition.y = nextY;
-
-    // Enemy Update (Movement & Damage)
-    AABB pBox{{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}};
-    float enemySpeed = 0.02f;
-
-    for (size_t i = 0; i < enemies.size(); i++) {
-        auto& enemy = enemies[i];
-        if (enemy.type == 'F') {
-            // Follower Logic: check LOS
-            if (hasLineOfSight(enemy.position, playerPosition)) {
-                glm::vec3 toPlayer = playerPosition - enemy.position;
-                toPlayer.y = 0.0f; // Only move on XZ
-                if (glm::length(toPlayer) > 0.1f) {
-                    glm::vec3 nextEnemyPos = enemy.position + glm::normalize(toPlayer) * enemySpeed;
-                    
-                    // Collision check for enemy
-                    bool enemyCollided = false;
-                    for (const auto& obs : obstacles) {
-                        if (nextEnemyPos.x + 0.5f > obs.min.x && nextEnemyPos.x - 0.5f < obs.max.x &&
-                            nextEnemyPos.z + 0.5f > obs.min.z && nextEnemyPos.z - 0.5f < obs.max.z) {
-                            enemyCollided = true;
-                            break;
-                        }
-                    }
-
-                    // Enemy-Enemy Collision
-                    if (!enemyCollided) {
-                        for (size_t j = 0; j < enemies.size(); j++) {
-                            if (i == j) continue;
-                            const auto& other = enemies[j];
-                            float dist = glm::distance(nextEnemyPos, other.position);
-                            if (dist < 0.8f) { // Slightly less than 1.0 to avoid sticking
-                                enemyCollided = true;
-                                break;
-                            }
-                        }
-                    }
+SimulationInput Engine::processInput() {
+    SimulationInput input{};
+    input.confirm = glfwGetKey(window, GLFW_KEY_ENTER) == GLFW_PRESS;
 
-                    if (!enemyCollided) {
-                        enemy.position = nextEnemyPos;
-                        enemy.box.min = enemy.position - glm::vec3(0.5f, 0.5f, 0.5f);
-                        enemy.box.max = enemy.position + glm::vec3(0.5f, 0.5f, 0.5f);
-                    }
-                }
-            }
-        }
-
-        // Damage Check
-        if (checkCollision(playerPosition, pBox, enemy.box)) {
-            takeDamage(0.5f, enemy.position); // Pass position for knockback
-        }
-    }
-
-    // Check Exit Collision
-    for (const auto& exit : exits) {
-        if (checkCollision(playerPosition, pBox, exit)) {
-            std::cout << "Fase completada! Carregando próxima fase...\n";
-            currentLevelIndex++;
-            loadLevel(currentLevelIndex);
-            break;
-        }
+    // Don't look around outside of gameplay
+    if (simulation->getState() != GameState::PLAYING) {
+        input.cameraYaw = cameraYaw;
+        return input;
     }
 
     // Mouse Input
@@ -495,9 +219,89 @@ void Engine::processInput() {
     // Constrain Pitch
     if (cameraPitch > 89.0f) cameraPitch = 89.0f;
     if (cameraPitch < -89.0f) cameraPitch = -89.0f;
+
+    input.forward = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+    input.back    = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+    input.left    = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+    input.right   = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+    input.jump    = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+    input.cameraYaw = cameraYaw;
+    return input;
+}
+
+void Engine::prepareFrame() {
+    bakeLevel();
+
+    // Blend the last two simulation states
+    glm::vec3 renderPlayerPosition = glm::mix(simulation->getPreviousPlayerPosition(), simulation->getPlayerPosition(), renderAlpha);
+
+    updateCamera(renderPlayerPosition);
+    
+    glm::mat4 projectionView = camera->getProjection() * camera->getView();
+    frustum.update(projectionView);
+    frameUniforms->update(currentFrame, projectionView, frustum);
+
+    // Per-frame instance list, in the order of the *_INSTANCE constants
+    instances.clear();
+    instances.push_back({glm::vec3(0.0f), glm::vec3(1.0f), GROUND_COLOR});
+    instances.push_back({glm::vec3(0.0f), glm::vec3(1.0f), OBSTACLE_COLOR});
+    instances.push_back({glm::vec3(0.0f), glm::vec3(1.0f), EXIT_COLOR});
+
+    // Player (Cyan/Blue); the camera follows it, so it is never culled
+    instances.push_back({renderPlayerPosition, glm::vec3(1.0f), PLAYER_COLOR});
+
+    cullBoxes.clear();
+    cullCandidates.clear();
+    auto addCandidate = [&](const glm::vec3& min, const glm::vec3& max, const glm::vec3& color) {
+        cullBoxes.push(min, max);
+        cullCandidates.push_back({(min + max) * 0.5f, max - min, color});
+    };
+
+    // Enemies (Magenta) and Followers (Orange)
+    const EnemyPool& enemies = simulation->getEnemies();
+    glm::vec3 enemyExtent(EnemyPool::HALF_EXTENT);
+    for (size_t i = 0; i < enemies.size(); i++) {
+        glm::vec3 position = glm::mix(enemies.previousPosition(i), enemies.position(i), renderAlpha);
+        addCandidate(position - enemyExtent, position + enemyExtent, i < enemies.getFollowerBegin() ? ENEMY_COLOR : FOLLOWER_COLOR);
+    }
+
+    cullVisible.resize(cullBoxes.size());
+    frustum.cull(cullBoxes, cullVisible.data());
+    for (size_t i = 0; i < cullCandidates.size(); i++) {
+        if (cullVisible[i]) instances.push_back(cullCandidates[i]);
+    }
+
+    // This frame slot's arena; its fence guarantees the GPU is done reading it.
+    // Instances are the first slice, so their offset only changes if the block grows.
+    frameArena->begin(currentFrame);
+    instanceSlice = frameArena->upload(instances.data(), sizeof(InstanceData) * instances.size(), alignof(InstanceData));
+    frameArena->flush();
+
+    // Level sections culled on the CPU turn into one draw each
+    visibleSections.clear();
+    if (!gpuCuller && !levelMesh->empty()) {
+        sectionVisible.resize(sectionBoxes.size());
+        frustum.cull(sectionBoxes, sectionVisible.data());
+        for (size_t i = 0; i < sectionVisible.size(); i++) {
+            if (sectionVisible[i]) visibleSections.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    frameSignature.state = simulation->getState();
+    frameSignature.levelGeneration = bakedGeneration;
+    frameSignature.instanceBlock = instanceSlice.blockSerial;
+    frameSignature.instanceOffset = instanceSlice.offset;
+    frameSignature.cubeCount = static_cast<uint32_t>(instances.size() - FIRST_CUBE_INSTANCE);
 }
 
-void Engine::recordCommandBuffer(VkCommandBuffer buffer, uint32_t imageIndex) {
+void Engine::recordCommandBuffer(Recording& recording, uint32_t recordingIndex, uint32_t imageIndex) {
+    VkCommandBuffer buffer = recording.commandBuffer;
+    vkResetCommandBuffer(buffer, 0);
+
+    // Only this frame slot submits the recording, and the slot's fence has signaled,
+    // so its secondary buffers are free to reuse
+    secondaryRecorder->reset(recordingIndex);
+
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
@@ -505,13 +309,24 @@ void Engine::recordCommandBuffer(VkCommandBuffer buffer, uint32_t imageIndex) {
         throw std::runtime_error("Falha ao iniciar gravacao do command buffer!");
     }
 
+    gpuProfiler->reset(buffer, currentFrame);
+    gpuProfiler->begin(buffer, currentFrame, profileRegions.frame);
+
+    // Compute work can't run inside a render pass
+    if (gpuCuller) {
+        gpuProfiler->begin(buffer, currentFrame, profileRegions.cull);
+        gpuCuller->cull(buffer, currentFrame);
+        gpuProfiler->end(buffer, currentFrame, profileRegions.cull);
+    }
+
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = swapchain->getRenderPass();
-    renderPassInfo.framebuffer = swapchain->getFramebuffers()[imageIndex];
+    renderPassInfo.renderPass = renderTarget->getRenderPass();
+    renderPassInfo.framebuffer = renderTarget->getFramebuffers()[imageIndex];
     renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = swapchain->getExtent();
+    renderPassInfo.renderArea.extent = renderTarget->getExtent();
 
+    GameState currentState = frameSignature.state;
     VkClearValue clearValues[2];
     if (currentState == GameState::MAIN_MENU) {
         clearValues[0].color = {{0.0f, 0.2f, 0.4f, 1.0f}}; 
@@ -527,106 +342,91 @@ void Engine::recordCommandBuffer(VkCommandBuffer buffer, uint32_t imageIndex) {
     renderPassInfo.clearValueCount = 2;
     renderPassInfo.pClearValues = clearValues;
 
-    vkCmdBeginRenderPass(buffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    // One recording task per category; CPU-culled level sections are split in chunks
+    recordTasks.clear();
+    recordTasks.push_back({profileRegions.ground, [this](VkCommandBuffer commandBuffer) {
+        groundMesh->bind(commandBuffer);
+        groundMesh->draw(commandBuffer, 1, GROUND_INSTANCE);
+    }});
+    uint32_t cubeCount = frameSignature.cubeCount;
+    recordTasks.push_back({profileRegions.cubes, [this, cubeCount](VkCommandBuffer commandBuffer) {
+        cubeMesh->bind(commandBuffer);
+        cubeMesh->draw(commandBuffer, cubeCount, FIRST_CUBE_INSTANCE);
+    }});
+
+    // Level: walls (Red) and exits (Green)
+    if (!levelMesh->empty()) {
+        if (gpuCuller) {
+            uint32_t frame = currentFrame;
+            recordTasks.push_back({profileRegions.level, [this, frame](VkCommandBuffer commandBuffer) {
+                levelMesh->bind(commandBuffer);
+                gpuCuller->draw(commandBuffer, frame, levelMesh->getMesh());
+            }});
+        } else {
+            for (size_t begin = 0; begin < visibleSections.size(); begin += SECTIONS_PER_RECORDING) {
+                size_t end = std::min(begin + SECTIONS_PER_RECORDING, visibleSections.size());
+                recordTasks.push_back({profileRegions.level, [this, begin, end](VkCommandBuffer commandBuffer) {
+                    const auto& sections = levelMesh->getSections();
+                    levelMesh->bind(commandBuffer);
+                    for (size_t i = begin; i < end; i++) {
+                        uint32_t section = visibleSections[i];
+                        levelMesh->drawSection(commandBuffer, section, sections[section].material == LevelMesh::Material::WALL ? WALL_INSTANCE : EXIT_INSTANCE);
+                    }
+                }});
+            }
+        }
+    }
 
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
-    viewport.width = static_cast<float>(swapchain->getExtent().width);
-    viewport.height = static_cast<float>(swapchain->getExtent().height);
+    viewport.width = static_cast<float>(renderTarget->getExtent().width);
+    viewport.height = static_cast<float>(renderTarget->getExtent().height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(buffer, 0, 1, &viewport);
 
     VkRect2D scissor{};
     scissor.offset = {0, 0};
-    scissor.extent = swapchain->getExtent();
-    vkCmdSetScissor(buffer, 0, 1, &scissor);
-
-    pipeline->bind(buffer);
-    
-    updateCamera();
-    
-    glm::mat4 projectionView = camera->getProjection() * camera->getView();
-
-    if (groundMesh) {
-        glm::mat4 model = glm::mat4(1.0f); 
-        glm::mat4 push = projectionView * model;
-        
-        vkCmdPushConstants(buffer, pipeline->getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &push);
-        groundMesh->bind(buffer);
-        groundMesh->draw(buffer);
-    }
-
-    if (playerMesh) {
-        // Draw Player
-        // Remove magic -0.5f offset, treat playerPosition as Center
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), playerPosition);   
-        glm::mat4 push = projectionView * model;
-
-        vkCmdPushConstants(buffer, pipeline->getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &push);
-        playerMesh->bind(buffer);
-        playerMesh->draw(buffer);
-    }
-        
-    if (obstacleMesh) {
-        obstacleMesh->bind(buffer);
-        // Draw Obstacles
-        for (const auto& obs : obstacles) {
-            // Calculate center from min/max
-            glm::vec3 center = (obs.min + obs.max) * 0.5f;
-            // Assuming 1x1x1 box mesh, scale it? bounds is 1 unit size?
-            // mesh is 1 width (-0.5 to 0.5).
-            // obstacle is {2, -1, 2} to {3, 0, 3} -> Size 1, Center 2.5, -0.5, 2.5
-            glm::mat4 obsModel = glm::translate(glm::mat4(1.0f), center);
-            glm::mat4 obsPush = projectionView * obsModel;
-            
-            vkCmdPushConstants(buffer, pipeline->getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &obsPush);
-            obstacleMesh->draw(buffer);
-        }
-    }
-
-    if (exitMesh) {
-        exitMesh->bind(buffer);
-        for (const auto& exit : exits) {
-            glm::vec3 center = (exit.min + exit.max) * 0.5f;
-            glm::mat4 exitModel = glm::translate(glm::mat4(1.0f), center);
-            glm::mat4 exitPush = projectionView * exitModel;
-            
-            vkCmdPushConstants(buffer, pipeline->getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &exitPush);
-            exitMesh->draw(buffer);
-        }
-    }
-
-    if (enemyMesh) {
-        enemyMesh->bind(buffer);
-        for (const auto& enemy : enemies) {
-            if (enemy.type == 'X') {
-                glm::mat4 enemyModel = glm::translate(glm::mat4(1.0f), enemy.position);
-                glm::mat4 enemyPush = projectionView * enemyModel;
-                vkCmdPushConstants(buffer, pipeline->getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &enemyPush);
-                enemyMesh->draw(buffer);
-            }
-        }
-    }
-
-    if (followerMesh) {
-        followerMesh->bind(buffer);
-        for (const auto& enemy : enemies) {
-            if (enemy.type == 'F') {
-                glm::mat4 enemyModel = glm::translate(glm::mat4(1.0f), enemy.position);
-                glm::mat4 enemyPush = projectionView * enemyModel;
-                vkCmdPushConstants(buffer, pipeline->getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &enemyPush);
-                followerMesh->draw(buffer);
-            }
+    scissor.extent = renderTarget->getExtent();
+
+    // Record every task into its own secondary buffer on the job threads. Secondary
+    // buffers inherit no state, so each one sets up the pipeline and bindings itself.
+    // The camera comes from the slot's uniforms; per-object transforms from the instance buffer.
+    // Consecutive tasks of one profiler region are timed as a whole, since they execute in order.
+    secondaryBuffers.resize(recordTasks.size());
+    jobSystem->parallelFor(recordTasks.size(), 1, [&](size_t begin, size_t end, unsigned threadIndex) {
+        for (size_t i = begin; i < end; i++) {
+            const RecordTask& task = recordTasks[i];
+            bool beginsRegion = i == 0 || recordTasks[i - 1].region != task.region;
+            bool endsRegion = i + 1 == recordTasks.size() || recordTasks[i + 1].region != task.region;
+
+            VkCommandBuffer commandBuffer = secondaryRecorder->begin(recordingIndex, threadIndex, renderPassInfo.renderPass, renderPassInfo.framebuffer);
+            if (beginsRegion) gpuProfiler->begin(commandBuffer, currentFrame, task.region);
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+            pipeline->bind(commandBuffer);
+            frameUniforms->bind(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->getPipelineLayout(), currentFrame);
+            vkCmdBindVertexBuffers(commandBuffer, 1, 1, &instanceSlice.buffer, &instanceSlice.offset);
+            task.record(commandBuffer);
+            if (endsRegion) gpuProfiler->end(commandBuffer, currentFrame, task.region);
+            SecondaryRecorder::end(commandBuffer);
+            secondaryBuffers[i] = commandBuffer; // Submission order stays the task order
         }
-    }
+    });
 
+    vkCmdBeginRenderPass(buffer, &renderPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+    vkCmdExecuteCommands(buffer, static_cast<uint32_t>(secondaryBuffers.size()), secondaryBuffers.data());
     vkCmdEndRenderPass(buffer);
 
+    gpuProfiler->end(buffer, currentFrame, profileRegions.frame);
+
     if (vkEndCommandBuffer(buffer) != VK_SUCCESS) {
         throw std::runtime_error("Falha ao finalizar gravacao do command buffer!");
     }
+
+    recording.signature = frameSignature;
+    recording.visibleSections = visibleSections;
+    recording.valid = true;
 }
 
 
@@ -644,67 +444,301 @@ void Engine::initWindow() {
     
     // Capture mouse
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+    glfwSetWindowUserPointer(window, this);
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow* resized, int, int) {
+        static_cast<Engine*>(glfwGetWindowUserPointer(resized))->framebufferResized = true;
+    });
 }
 
 void Engine::run() {
-    if (!isInitialized) return;
+    if (!isInitialized || !window) return;
+
+    double previousTime = glfwGetTime();
+    double accumulator = 0.0;
+    double lastProfileLog = previousTime;
 
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
+
+        double now = glfwGetTime();
+        // Clamp long stalls so the sim catches up with a bounded number of ticks
+        accumulator += std::min(now - previousTime, MAX_FRAME_TIME);
+        previousTime = now;
         
-        processInput();
+        SimulationInput input = processInput();
+
+        while (accumulator >= SIMULATION_DT) {
+            simulation->step(input, static_cast<float>(SIMULATION_DT));
+            accumulator -= SIMULATION_DT;
+        }
+        renderAlpha = static_cast<float>(accumulator / SIMULATION_DT);
         
         drawFrame();
+
+        if (config.gpuProfileLogInterval > 0.0 && now - lastProfileLog >= config.gpuProfileLogInterval) {
+            lastProfileLog = now;
+            std::string stats = gpuProfiler->formatStats();
+            if (!stats.empty()) std::cout << "GPU ms (min/avg/max): " << stats << "\n";
+            std::cout << "Memoria GPU: " << vulkanContext->getMemoryBudget().formatHeapUsage() << "\n";
+        }
+
+        bool statsKey = glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS;
+        if (statsKey && !statsKeyHeld && dumpMemoryStats(config.memoryStatsPath)) {
+            std::cout << "Estatisticas de memoria gravadas em " << config.memoryStatsPath << "\n";
+        }
+        statsKeyHeld = statsKey;
     }
     vkDeviceWaitIdle(vulkanContext->getDevice());
 }
 
 
-void Engine::createCommandBuffer() {
+void Engine::createFrameResources() {
+    VkDevice device = vulkanContext->getDevice();
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT; // First wait on each frame returns immediately
+
+    for (auto& frame : frames) {
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS ||
+            vkCreateFence(device, &fenceInfo, nullptr, &frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar objetos de sincronizacao!");
+        }
+    }
+    frameArena = std::make_unique<FrameArena>(vulkanContext.get(), MAX_FRAMES_IN_FLIGHT, FRAME_ARENA_BLOCK_SIZE, FRAME_ARENA_USAGE);
+
+    createSwapchainResources();
+}
+
+void Engine::destroyFrameResources() {
+    VkDevice device = vulkanContext->getDevice();
+
+    for (auto& frame : frames) {
+        vkDestroySemaphore(device, frame.imageAvailable, nullptr);
+        vkDestroyFence(device, frame.inFlight, nullptr);
+        frame = FrameData{};
+    }
+    frameArena.reset();
+    destroySwapchainResources();
+}
+
+void Engine::createSwapchainResources() {
+    VkDevice device = vulkanContext->getDevice();
+    uint32_t imageCount = static_cast<uint32_t>(renderTarget->getFramebuffers().size());
+
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    // Indexed by swapchain image: the presentation engine may still be waiting on an
+    // image's semaphore when the same frame slot comes around again. Unused offscreen.
+    renderFinished.resize(imageCount);
+    for (auto& semaphore : renderFinished) {
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar objetos de sincronizacao!");
+        }
+    }
+
+    // A recording bakes in both the framebuffer and the frame slot's resources
+    recordings.resize(MAX_FRAMES_IN_FLIGHT * imageCount);
+    std::vector<VkCommandBuffer> commandBuffers(recordings.size());
+
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool = vulkanContext->getCommandPool();
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = 1;
+    allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
 
-    if (vkAllocateCommandBuffers(vulkanContext->getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+    if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
         throw std::runtime_error("Falha ao alocar command buffers!");
     }
+    for (size_t i = 0; i < recordings.size(); i++) {
+        recordings[i].commandBuffer = commandBuffers[i];
+    }
+    secondaryRecorder = std::make_unique<SecondaryRecorder>(vulkanContext.get(), static_cast<uint32_t>(recordings.size()), jobSystem->getThreadCount());
+}
+
+void Engine::destroySwapchainResources() {
+    VkDevice device = vulkanContext->getDevice();
+    for (auto semaphore : renderFinished) {
+        vkDestroySemaphore(device, semaphore, nullptr);
+    }
+    renderFinished.clear();
+
+    secondaryRecorder.reset();
+    for (auto& recording : recordings) {
+        vkFreeCommandBuffers(device, vulkanContext->getCommandPool(), 1, &recording.commandBuffer);
+    }
+    recordings.clear();
+}
+
+void Engine::recreateSwapchain() {
+    // A minimized window has a zero-sized framebuffer, which no swapchain can match
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    while ((framebufferWidth == 0 || framebufferHeight == 0) && !glfwWindowShouldClose(window)) {
+        glfwWaitEvents();
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    }
+    if (framebufferWidth == 0 || framebufferHeight == 0) return; // Closed while minimized
+
+    // Every frame in flight may still render to or present an old image
+    vkDeviceWaitIdle(vulkanContext->getDevice());
+
+    width = framebufferWidth;
+    height = framebufferHeight;
+    swapchain->recreate(static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+
+    // The image count may change, a failed present may leave its semaphore signaled,
+    // and every recording refers to an old framebuffer
+    destroySwapchainResources();
+    createSwapchainResources();
+    framebufferResized = false;
 }
 
 void Engine::drawFrame() {
-    vkb::Swapchain vkbSwapchain = swapchain->getSwapchain();
-    
-    uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(vulkanContext->getDevice(), vkbSwapchain.swapchain, UINT64_MAX, VK_NULL_HANDLE, VK_NULL_HANDLE, &imageIndex);
-    
-    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-        return;
+    FrameData& frame = frames[currentFrame];
+
+    // Only wait for the GPU to finish the frame that last used this slot
+    vkWaitForFences(vulkanContext->getDevice(), 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+    gpuProfiler->collect(currentFrame); // Its timestamps are final now
+
+    MemoryBudget& memoryBudget = vulkanContext->getMemoryBudget();
+    memoryBudget.setFrameIndex(++frameNumber);
+    memoryBudget.checkBudget();
+
+    // Offscreen, every frame slot owns one image and nothing is presented
+    uint32_t imageIndex = currentFrame;
+    VkResult result = VK_SUCCESS;
+    if (swapchain) {
+        result = vkAcquireNextImageKHR(vulkanContext->getDevice(), swapchain->getSwapchain().swapchain, UINT64_MAX, frame.imageAvailable, VK_NULL_HANDLE, &imageIndex);
+
+        // Nothing was acquired, so the semaphore is unsignaled and the fence untouched.
+        // SUBOPTIMAL still returns an image: render it and recreate after presenting.
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            recreateSwapchain();
+            return;
+        }
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+            throw std::runtime_error("Falha ao adquirir imagem da swapchain!");
+        }
+    }
+
+    // Reset only once work is certain to be submitted, or the next wait would never return
+    vkResetFences(vulkanContext->getDevice(), 1, &frame.inFlight);
+
+    // Dynamic data is written to buffers every frame; commands are only recorded
+    // again when something they bake in changed (e.g. never while a menu is shown)
+    prepareFrame();
+    uint32_t recordingIndex = currentFrame * static_cast<uint32_t>(renderFinished.size()) + imageIndex;
+    Recording& recording = recordings[recordingIndex];
+    if (!recording.valid || recording.signature != frameSignature || recording.visibleSections != visibleSections) {
+        recordCommandBuffer(recording, recordingIndex, imageIndex);
     }
 
-    vkResetCommandBuffer(commandBuffer, 0);
-    recordCommandBuffer(commandBuffer, imageIndex);
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    if (swapchain) {
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &frame.imageAvailable;
+        submitInfo.pWaitDstStageMask = &waitStage;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &renderFinished[imageIndex];
+    }
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
+    submitInfo.pCommandBuffers = &recording.commandBuffer;
 
-    vkQueueSubmit(vulkanContext->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-    
-    vkQueueWaitIdle(vulkanContext->getGraphicsQueue());
+    if (vkQueueSubmit(vulkanContext->getGraphicsQueue(), 1, &submitInfo, frame.inFlight) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao submeter command buffer!");
+    }
+    gpuProfiler->markSubmitted(currentFrame);
+    lastImage = imageIndex;
+
+    if (!swapchain) {
+        currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+        return;
+    }
 
+    vkb::Swapchain vkbSwapchain = swapchain->getSwapchain();
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &renderFinished[imageIndex];
     presentInfo.swapchainCount = 1;
     presentInfo.pSwapchains = &vkbSwapchain.swapchain;
     presentInfo.pImageIndices = &imageIndex;
 
-    vkQueuePresentKHR(vulkanContext->getGraphicsQueue(), &presentInfo);
+    result = vkQueuePresentKHR(vulkanContext->getGraphicsQueue(), &presentInfo);
+
+    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) {
+        recreateSwapchain();
+    } else if (result != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao apresentar imagem da swapchain!");
+    }
+}
+
+void Engine::step(const SimulationInput& input, float dt) {
+    simulation->step(input, dt);
+    renderAlpha = 1.0f; // Render exactly the state that was just simulated
+    drawFrame();
 }
 
-void Engine::updateCamera() {
-    float aspectRatio = swapchain->getExtent().width / (float)swapchain->getExtent().height;
+void Engine::setCameraAngles(float yaw, float pitch) {
+    cameraYaw = yaw;
+    cameraPitch = pitch;
+}
+
+void Engine::readLastFrame(std::vector<uint8_t>& rgba) {
+    if (!offscreenTarget) {
+        throw std::runtime_error("Leitura de frame so e suportada no modo offscreen!");
+    }
+    vkDeviceWaitIdle(vulkanContext->getDevice());
+    offscreenTarget->readback(lastImage, rgba);
+}
+
+const MemoryBudget* Engine::getMemoryBudget() const {
+    return isInitialized ? &vulkanContext->getMemoryBudget() : nullptr;
+}
+
+bool Engine::dumpMemoryStats(const std::string& path) const {
+    return isInitialized && vulkanContext->getMemoryBudget().dumpJson(path);
+}
+
+void Engine::bakeLevel() {
+    if (levelMesh && simulation->getLevelGeneration() == bakedGeneration) return;
+    bakedGeneration = simulation->getLevelGeneration();
+
+    // Frames in flight may still draw the previous level's mesh
+    vkDeviceWaitIdle(vulkanContext->getDevice());
+
+    const LevelGrid& grid = simulation->getLevelGrid();
+    std::vector<glm::ivec2> exitCells;
+    for (const auto& exit : simulation->getExits()) {
+        exitCells.push_back(grid.cellOf((exit.min + exit.max) * 0.5f));
+    }
+    levelMesh = std::make_unique<LevelMesh>(vulkanContext.get(), grid, exitCells);
+
+    sectionBoxes.clear();
+    std::vector<CullDraw> draws;
+    for (const auto& section : levelMesh->getSections()) {
+        sectionBoxes.push(section.min, section.max);
+        glm::vec3 color = section.material == LevelMesh::Material::WALL ? OBSTACLE_COLOR : EXIT_COLOR;
+        draws.push_back({section.min, section.max, section.firstIndex, section.indexCount, {glm::vec3(0.0f), glm::vec3(1.0f), color}});
+    }
+    if (gpuCuller) gpuCuller->setDraws(draws);
+}
+
+void Engine::updateCamera(const glm::vec3& target) {
+    float aspectRatio = renderTarget->getExtent().width / (float)renderTarget->getExtent().height;
     camera->setPerspectiveProjection(glm::radians(50.0f), aspectRatio, 0.1f, 100.0f);
     
     // Calculate Camera Offset based on Yaw/Pitch (Spherical to Cartesian)
@@ -735,7 +769,6 @@ void Engine::updateCamera() {
     // So if Pitch=20, vDistance is +; offsetY becomes - (Up). Correct.
     
     glm::vec3 cameraOffset = {offsetX, offsetY, offsetZ};
-    glm::vec3 target = playerPosition;
     glm::vec3 position = target + cameraOffset;
     
     camera->setViewTarget(position, target);
@@ -749,18 +782,24 @@ void Engine::cleanup() {
             swapchain->cleanup();
         }
 
-        obstacleMesh.reset();
-        enemyMesh.reset();
-        followerMesh.reset();
-        exitMesh.reset();
+        destroyFrameResources();
+        offscreenTarget.reset();
+        gpuCuller.reset();
+        levelMesh.reset();
+        cubeMesh.reset();
         pipeline.reset(); 
+        frameUniforms.reset();
+        gpuProfiler.reset();
         camera.reset();
         groundMesh.reset();
-        playerMesh.reset();
         vulkanContext->cleanup(); // Destroys allocator
+        simulation.reset();
+        jobSystem.reset();
         
-        glfwDestroyWindow(window);
-        glfwTerminate();
+        if (window) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+        }
         isInitialized = false;
     }
 }
@@ -1,82 +1,189 @@
 #pragma once
 
+#include <array>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
+#include "Frustum.h"
+#include "JobSystem.h"
+#include "Simulation.h"
+#include "../renderer/FrameArena.h"
 
 struct GLFWwindow;
 class VulkanContext;
 class Swapchain;
+class RenderTarget;
+class OffscreenTarget;
 class Pipeline;
 class Mesh;
+class FrameArena;
+class GpuCuller;
+class LevelMesh;
+class SecondaryRecorder;
+class FrameUniforms;
+class GpuProfiler;
+class MemoryBudget;
+struct InstanceData;
 class Camera;
 
+// Where the baked level sections (walls, exits) are frustum culled. Enemies are always culled on the CPU.
+enum class CullingMode {
+    CPU, // Batch test in recordCommandBuffer, one draw per visible section
+    GPU  // Compute pass plus one multi-draw indirect call (GpuCuller)
+};
+
+// How finished frames reach the screen. Unsupported modes fall back (see Swapchain)
+enum class PresentMode {
+    FIFO,     // V-Sync, always available
+    MAILBOX,  // Uncapped, no tearing: the newest frame replaces a waiting one
+    IMMEDIATE // Uncapped, may tear: lowest latency, for benchmark runs
+};
+
+// Startup options, parsed from the command line in main
+struct EngineConfig {
+    CullingMode culling{CullingMode::GPU};
+    PresentMode presentMode{PresentMode::FIFO};
+    double gpuProfileLogInterval{5.0}; // Seconds between GPU timing and memory log lines, 0 to disable
+    std::string memoryStatsPath{"vma_stats.json"}; // Where F9 dumps the VMA statistics JSON
+
+    // Render into VMA images instead of a window (no surface, works on lavapipe).
+    // The caller drives frames with step() instead of run().
+    bool offscreen{false};
+    int width{1280};
+    int height{720};
+};
+
 class Engine {
 public:
-    Engine();
+    explicit Engine(const EngineConfig& config = {});
     ~Engine();
 
     void init();
     void run();
     void cleanup();
 
+    // Rolling GPU timings per region (frame, cull, ground, cubes, level); null before init
+    const GpuProfiler* getGpuProfiler() const { return gpuProfiler.get(); }
+
+    // Caller-driven frames (offscreen mode): one simulation tick, then one rendered frame
+    // of exactly that state. The camera keeps the angles given to setCameraAngles.
+    void step(const SimulationInput& input, float dt);
+    void setCameraAngles(float yaw, float pitch);
+    Simulation& getSimulation() { return *simulation; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Waits for the GPU and copies the last rendered frame (RGBA8, top row first); offscreen only
+    void readLastFrame(std::vector<uint8_t>& rgba);
+
+    // GPU heap usage versus budget; null before init
+    const MemoryBudget* getMemoryBudget() const;
+    bool dumpMemoryStats(const std::string& path) const;
+
 private:
     void initWindow();
+
+    EngineConfig config;
     
-    int width{1280};
-    int height{720};
+    int width;
+    int height;
     std::string windowTitle{"Platformer 3D"};
     
     GLFWwindow* window{nullptr};
+    bool framebufferResized{false}; // Set by the GLFW callback, handled in drawFrame
     std::unique_ptr<VulkanContext> vulkanContext;
-    std::unique_ptr<Swapchain> swapchain;
+    std::unique_ptr<Swapchain> swapchain;             // Window mode
+    std::unique_ptr<OffscreenTarget> offscreenTarget; // Offscreen mode
+    RenderTarget* renderTarget{nullptr};              // Whichever of the two exists
+    uint32_t lastImage{0};                            // Target image of the last submitted frame
     std::unique_ptr<Pipeline> pipeline;
+    std::unique_ptr<FrameUniforms> frameUniforms; // Camera per frame slot, set 0
+    std::unique_ptr<GpuProfiler> gpuProfiler;
+    struct ProfileRegions {
+        uint32_t frame{0};
+        uint32_t cull{0};
+        uint32_t ground{0};
+        uint32_t cubes{0};
+        uint32_t level{0};
+    } profileRegions;
     
     std::unique_ptr<Camera> camera;
+    std::unique_ptr<JobSystem> jobSystem;
     std::unique_ptr<Mesh> groundMesh;
-    std::unique_ptr<Mesh> playerMesh;
-    std::unique_ptr<Mesh> obstacleMesh;
-    std::unique_ptr<Mesh> exitMesh;
-    std::unique_ptr<Mesh> enemyMesh;
-    std::unique_ptr<Mesh> followerMesh;
-    
-    VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
-
-    enum class GameState { MAIN_MENU, PLAYING, GAME_OVER, VICTORY };
-    GameState currentState{GameState::MAIN_MENU};
-
-    // Game State
-    float playerHealth{100.0f};
-    float maxHealth{100.0f};
-    glm::vec3 playerPosition{0.0f, 1.0f, 0.0f}; // Start slightly above ground
-    float playerVelocityY{0.0f};
-    bool isGrounded{false};
-    float playerRotation{0.0f};
-    glm::vec3 playerKnockback{0.0f};
-
-    // Physics State
-    struct AABB {
-        glm::vec3 min;
-        glm::vec3 max;
+    std::unique_ptr<Mesh> cubeMesh;
+    std::vector<InstanceData> instances; // Rebuilt every frame
+
+    // Frustum culling: level objects are tested in one batch before any reach the instance list
+    Frustum frustum;
+    BoxBatch cullBoxes;
+    std::vector<InstanceData> cullCandidates; // Parallel to cullBoxes
+    std::vector<uint8_t> cullVisible;
+
+    // Walls and exits baked into chunked sections when the level changes
+    std::unique_ptr<LevelMesh> levelMesh;
+    uint32_t bakedGeneration{0}; // Simulation level generation the mesh was baked from
+    BoxBatch sectionBoxes; // Section bounds for CPU culling
+    std::vector<uint8_t> sectionVisible;
+    std::unique_ptr<GpuCuller> gpuCuller; // Only with CullingMode::GPU
+
+    // Parallel recording: each task fills one secondary command buffer inside the render pass
+    static constexpr size_t SECTIONS_PER_RECORDING = 256; // CPU-culled section draws per task
+    std::unique_ptr<SecondaryRecorder> secondaryRecorder;
+    struct RecordTask {
+        uint32_t region; // GpuProfiler region, timed from its first task to its last
+        std::function<void(VkCommandBuffer)> record;
     };
+    std::vector<RecordTask> recordTasks;
+    std::vector<VkCommandBuffer> secondaryBuffers; // Parallel to recordTasks
+    std::vector<uint32_t> visibleSections; // CPU-culled level sections of this frame
     
-    struct Enemy {
-        AABB box;
-        glm::vec3 position;
-        char type; // 'X' or 'F'
+    // Frames in flight: the CPU records frame N+1 while the GPU renders frame N
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+    struct FrameData {
+        VkSemaphore imageAvailable{VK_NULL_HANDLE};
+        VkFence inFlight{VK_NULL_HANDLE};
     };
-    
-    std::vector<AABB> obstacles;
-    std::vector<AABB> exits;
-    std::vector<Enemy> enemies;
-    float minX{0}, maxX{0}, minZ{0}, maxZ{0};
-    int currentLevelIndex = 0;
-    bool checkCollision(const glm::vec3& pos, const AABB& playerBox, const AABB& obstacle);
-    bool hasLineOfSight(const glm::vec3& start, const glm::vec3& end);
-    void takeDamage(float amount, const glm::vec3& sourcePos = glm::vec3(0.0f));
-    void restartLevel();
+    std::array<FrameData, MAX_FRAMES_IN_FLIGHT> frames;
+
+    // Transient per-frame data (instances now; uniforms or indirect args can share it)
+    static constexpr VkDeviceSize FRAME_ARENA_BLOCK_SIZE = 256 * 1024;
+    static constexpr VkBufferUsageFlags FRAME_ARENA_USAGE = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                                            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+    std::unique_ptr<FrameArena> frameArena;
+    FrameArena::Slice instanceSlice; // This frame's instances, bound at binding 1
+    std::vector<VkSemaphore> renderFinished; // One per swapchain image
+    uint32_t currentFrame{0};
+    uint32_t frameNumber{0}; // Frames drawn so far, for VMA's budget refresh
+
+    // Recorded command buffers are reused while nothing they bake in changes.
+    // Camera and instance data live in buffers, so they are not part of it.
+    struct RecordSignature {
+        GameState state{GameState::MAIN_MENU}; // Clear color
+        uint32_t levelGeneration{0};
+        uint64_t instanceBlock{0}; // Arena block serial, not its handle: a freed handle value can come back
+        VkDeviceSize instanceOffset{0};
+        uint32_t cubeCount{0};
+
+        bool operator==(const RecordSignature&) const = default;
+    };
+    struct Recording {
+        VkCommandBuffer commandBuffer{VK_NULL_HANDLE};
+        bool valid{false};
+        RecordSignature signature;
+        std::vector<uint32_t> visibleSections; // CPU culling only
+    };
+    std::vector<Recording> recordings; // frame slot * image count + image index
+    RecordSignature frameSignature; // Of the frame being prepared
+
+    std::unique_ptr<Simulation> simulation;
+
+    // Fixed-rate simulation; rendering interpolates between the last two ticks
+    static constexpr double SIMULATION_DT = 1.0 / 60.0;
+    static constexpr double MAX_FRAME_TIME = 0.25;
+    float renderAlpha{1.0f};
 
     // Camera State
     float cameraYaw{0.0f};   // Angle around Y axis
@@ -87,15 +194,21 @@ private:
     double lastMouseX{0.0};
     double lastMouseY{0.0};
     bool firstMouse{true};
+    bool statsKeyHeld{false};
 
-    void processInput();
+    SimulationInput processInput();
     void createPipeline();
-    void createCommandBuffer();
+    void createFrameResources();
+    void destroyFrameResources();
+    void createSwapchainResources();
+    void destroySwapchainResources();
+    void recreateSwapchain();
     void createScene();
-    void loadLevel(int levelIndex);
-    void updateCamera();
+    void updateCamera(const glm::vec3& target);
+    void bakeLevel();
     void drawFrame();
-    void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    void prepareFrame();
+    void recordCommandBuffer(Recording& recording, uint32_t recordingIndex, uint32_t imageIndex);
 
     bool isInitialized{false};
 };
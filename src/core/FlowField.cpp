@@ -0,0 +1,75 @@
+#include "FlowField.h"
+#include <algorithm>
+
+bool FlowField::update(const LevelGrid& levelGrid, const glm::vec3& goal) {
+    glm::ivec2 cell = levelGrid.cellOf(goal);
+    cell.x = std::clamp(cell.x, 0, std::max(levelGrid.getColumns() - 1, 0));
+    cell.y = std::clamp(cell.y, 0, std::max(levelGrid.getRows() - 1, 0));
+
+    if (valid && grid == &levelGrid && cell == goalCell) return false;
+
+    grid = &levelGrid;
+    goalCell = cell;
+    columns = levelGrid.getColumns();
+    rows = levelGrid.getRows();
+    valid = true;
+
+    size_t cellCount = static_cast<size_t>(columns) * rows;
+    distances.assign(cellCount, UNREACHABLE);
+    nextCell.assign(cellCount, -1);
+    frontier.clear();
+    if (cellCount == 0) return true;
+
+    // The goal is seeded even if it is a wall (the player can stand on top of one)
+    int goalIndex = goalCell.y * columns + goalCell.x;
+    distances[goalIndex] = 0;
+    frontier.push_back(goalIndex);
+
+    // Fixed neighbour order keeps the chosen paths deterministic
+    constexpr int OFFSETS[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    for (size_t head = 0; head < frontier.size(); head++) {
+        int index = frontier[head];
+        int column = index % columns;
+        int row = index / columns;
+        for (const auto& offset : OFFSETS) {
+            int nc = column + offset[0];
+            int nr = row + offset[1];
+            if (!levelGrid.inBounds(nc, nr) || levelGrid.isWall(nc, nr)) continue;
+
+            int neighbour = nr * columns + nc;
+            if (distances[neighbour] != UNREACHABLE) continue;
+            distances[neighbour] = distances[index] + 1;
+            nextCell[neighbour] = index; // First discovery is a shortest step back toward the goal
+            frontier.push_back(neighbour);
+        }
+    }
+    return true;
+}
+
+int FlowField::distance(int column, int row) const {
+    if (!valid || column < 0 || row < 0 || column >= columns || row >= rows) return UNREACHABLE;
+    return distances[row * columns + column];
+}
+
+bool FlowField::nextWaypoint(const glm::vec3& position, glm::vec3& waypoint) const {
+    if (!valid) return false;
+
+    glm::ivec2 cell = grid->cellOf(position);
+    if (cell.x < 0 || cell.y < 0 || cell.x >= columns || cell.y >= rows) return false;
+
+    int next = nextCell[cell.y * columns + cell.x];
+    if (next < 0) return false;
+
+    // Steps are axis aligned between cell centers. A body off the line to the next
+    // cell first returns to its own cell's center: moving straight toward it never
+    // grows the overlap with a neighbouring cell, so a cell-sized body never clips
+    // a wall corner on the way. The test is exact on purpose: a body that arrives
+    // a hair off (float drift) snaps back to the center within one step.
+    glm::vec3 center = grid->cellCenter(cell.x, cell.y);
+    bool stepAlongX = next % columns != cell.x;
+    bool onLine = stepAlongX ? position.z == center.z : position.x == center.x;
+
+    waypoint = onLine ? grid->cellCenter(next % columns, next / columns) : center;
+    waypoint.y = position.y;
+    return true;
+}
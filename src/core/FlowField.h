@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "LevelGrid.h"
+
+// Shared path guidance toward one goal (the player) over the level grid.
+// A BFS from the goal cell stores, for every reachable open cell, the next cell
+// on a shortest 4-connected path, so each follower does an O(1) lookup instead
+// of its own search. The field is only rebuilt when the goal changes cell.
+class FlowField {
+public:
+    static constexpr int UNREACHABLE = -1;
+
+    // Forget the current field (e.g. after a level load); the next update rebuilds
+    void invalidate() { valid = false; }
+
+    // Rebuilds if the goal moved to another cell since the last build. Returns true if it did.
+    bool update(const LevelGrid& grid, const glm::vec3& goal);
+
+    // Steps to the goal from a cell, UNREACHABLE for walls, out of bounds or cut-off cells
+    int distance(int column, int row) const;
+
+    // Where a follower at position should head next, keeping position.y: the center of
+    // the next cell toward the goal, or its own cell's center while it is off that line.
+    // False when position is already in the goal cell or cannot reach it.
+    bool nextWaypoint(const glm::vec3& position, glm::vec3& waypoint) const;
+
+private:
+    const LevelGrid* grid{nullptr};
+    bool valid{false};
+    glm::ivec2 goalCell{0, 0};
+    int columns{0};
+    int rows{0};
+    std::vector<int> distances;
+    std::vector<int> nextCell; // Cell index one step closer to the goal, -1 if none
+    std::vector<int> frontier; // BFS queue, kept to avoid reallocating
+};
@@ -0,0 +1,96 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE2 1
+#endif
+
+void BoxBatch::clear() {
+    for (auto* array : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ}) {
+        array->clear();
+    }
+}
+
+void BoxBatch::push(const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    extentX.push_back(extent.x);
+    extentY.push_back(extent.y);
+    extentZ.push_back(extent.z);
+}
+
+void Frustum::update(const glm::mat4& projectionView) {
+    // glm is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&](int i) {
+        return glm::vec4{projectionView[0][i], projectionView[1][i], projectionView[2][i], projectionView[3][i]};
+    };
+    glm::vec4 x = row(0), y = row(1), z = row(2), w = row(3);
+
+    planes[0] = w + x; // Left
+    planes[1] = w - x; // Right
+    planes[2] = w + y; // Bottom
+    planes[3] = w - y; // Top
+    planes[4] = z;     // Near (clip z >= 0)
+    planes[5] = w - z; // Far
+
+    for (auto& plane : planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+bool Frustum::intersects(const glm::vec3& min, const glm::vec3& max) const {
+    glm::vec3 center = (min + max) * 0.5f;
+    glm::vec3 extent = (max - min) * 0.5f;
+    for (const auto& plane : planes) {
+        glm::vec3 normal(plane);
+        // Distance of the box's most inward corner from the plane
+        float distance = glm::dot(normal, center) + plane.w;
+        float radius = glm::dot(glm::abs(normal), extent);
+        if (distance + radius < 0.0f) return false;
+    }
+    return true;
+}
+
+void Frustum::cull(const BoxBatch& boxes, uint8_t* visible) const {
+    size_t count = boxes.size();
+    size_t i = 0;
+
+#ifdef FRUSTUM_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(boxes.centerX.data() + i);
+        __m128 cy = _mm_loadu_ps(boxes.centerY.data() + i);
+        __m128 cz = _mm_loadu_ps(boxes.centerZ.data() + i);
+        __m128 ex = _mm_loadu_ps(boxes.extentX.data() + i);
+        __m128 ey = _mm_loadu_ps(boxes.extentY.data() + i);
+        __m128 ez = _mm_loadu_ps(boxes.extentZ.data() + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w)));
+            __m128 radius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::fabs(plane.y)), ey)),
+                _mm_mul_ps(_mm_set1_ps(std::fabs(plane.z)), ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        int bits = _mm_movemask_ps(inside);
+        visible[i + 0] = static_cast<uint8_t>(bits & 1);
+        visible[i + 1] = static_cast<uint8_t>((bits >> 1) & 1);
+        visible[i + 2] = static_cast<uint8_t>((bits >> 2) & 1);
+        visible[i + 3] = static_cast<uint8_t>((bits >> 3) & 1);
+    }
+#endif
+
+    for (; i < count; i++) {
+        glm::vec3 center{boxes.centerX[i], boxes.centerY[i], boxes.centerZ[i]};
+        glm::vec3 extent{boxes.extentX[i], boxes.extentY[i], boxes.extentZ[i]};
+        visible[i] = intersects(center - extent, center + extent) ? 1 : 0;
+    }
+}
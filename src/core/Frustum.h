@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Axis-aligned boxes as parallel arrays of centers and half extents, so the
+// frustum test can take four boxes per SIMD step.
+struct BoxBatch {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+
+    size_t size() const { return centerX.size(); }
+    void clear();
+    void push(const glm::vec3& min, const glm::vec3& max);
+};
+
+// View frustum as six inward-facing planes, extracted from a projection * view
+// matrix with Vulkan's [0, 1] clip depth (see Camera).
+class Frustum {
+public:
+    void update(const glm::mat4& projectionView);
+
+    // True if the box is at least partly inside. Conservative: a box near a
+    // frustum corner can pass while being outside.
+    bool intersects(const glm::vec3& min, const glm::vec3& max) const;
+
+    // visible[i] = 1 if box i intersects the frustum, 0 otherwise
+    void cull(const BoxBatch& boxes, uint8_t* visible) const;
+
+    // Left, right, bottom, top, near, far (e.g. for the GPU cull pass)
+    const glm::vec4* getPlanes() const { return planes; }
+
+private:
+    glm::vec4 planes[6]{}; // xyz = normal, w = distance; inside where dot(n, p) + w >= 0
+};
@@ -0,0 +1,133 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    // Queue of the thread currently running; 0 for the owner (and any non-worker) thread
+    thread_local unsigned currentThreadIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount) : ownerThread(std::this_thread::get_id()) {
+    if (workerCount == 0) {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    for (unsigned i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (unsigned i = 1; i <= workerCount; i++) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeFn& fn) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    assert((currentThreadIndex != 0 || std::this_thread::get_id() == ownerThread) && "parallelFor fora da thread dona");
+
+    // Not worth waking anyone
+    if (workers.empty() || count <= grain) {
+        fn(0, count, currentThreadIndex);
+        return;
+    }
+
+    size_t chunks = (count + grain - 1) / grain;
+    Batch batch;
+    batch.fn = &fn;
+    batch.remaining = chunks;
+
+    // Counted before publishing so the counter never dips below the queued work
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedJobs += chunks;
+    }
+
+    // Deal chunks round-robin so every queue starts with local work
+    for (size_t c = 0; c < chunks; c++) {
+        Job job{&batch, c * grain, std::min(count, (c + 1) * grain)};
+        auto& queue = *queues[c % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    wake.notify_all();
+
+    unsigned self = currentThreadIndex;
+    Job job;
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        if (popOrSteal(self, job)) {
+            execute(job, self);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    // Only now is no job left pointing at batch or fn
+    if (batch.error) std::rethrow_exception(batch.error);
+}
+
+void JobSystem::workerLoop(unsigned index) {
+    currentThreadIndex = index;
+
+    Job job;
+    while (true) {
+        if (popOrSteal(index, job)) {
+            execute(job, index);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return !running || queuedJobs.load() > 0; });
+        if (!running) return;
+    }
+}
+
+bool JobSystem::popOrSteal(unsigned index, Job& job) {
+    // Own queue first, newest work (back) for locality
+    {
+        auto& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            queuedJobs--;
+            return true;
+        }
+    }
+
+    // Steal the oldest work (front) from the others
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        auto& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job, unsigned index) {
+    Batch& batch = *job.batch;
+    try {
+        (*batch.fn)(job.begin, job.end, index);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(batch.errorMutex);
+        if (!batch.error) batch.error = std::current_exception();
+    }
+    // Last touch of batch: the caller may return as soon as this reaches 0
+    batch.remaining.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing scheduler. Every thread (the owner thread is index 0,
+// workers are 1..N) has its own deque: it pops its own work from the back and
+// steals from the front of the others when it runs dry.
+class JobSystem {
+public:
+    // fn(begin, end, threadIndex); threadIndex < getThreadCount(), handy for per-thread scratch
+    using RangeFn = std::function<void(size_t, size_t, unsigned)>;
+
+    // workerCount == 0 picks hardware_concurrency() - 1 (the owner thread also works)
+    explicit JobSystem(unsigned workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(queues.size()); }
+
+    // Splits [0, count) into chunks of at most 'grain' items and runs them on all
+    // threads. Blocks until every chunk finished; the calling thread helps meanwhile.
+    // Chunk boundaries only depend on count and grain, never on timing.
+    // If chunks throw, the rest still run and the first exception is rethrown here.
+    // Call it from the thread that created the JobSystem (or from inside fn): any other
+    // thread would share threadIndex 0, and with it per-thread scratch, with the owner.
+    void parallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+private:
+    // One parallelFor call; lives on its caller's stack until remaining reaches 0
+    struct Batch {
+        const RangeFn* fn{nullptr};
+        std::atomic<size_t> remaining{0};
+        std::mutex errorMutex;
+        std::exception_ptr error; // First exception thrown by a chunk
+    };
+
+    struct Job {
+        Batch* batch{nullptr};
+        size_t begin{0};
+        size_t end{0};
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void workerLoop(unsigned index);
+    bool popOrSteal(unsigned index, Job& job);
+    void execute(const Job& job, unsigned index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queuedJobs{0};
+    std::atomic<bool> running{true};
+    std::thread::id ownerThread;
+};
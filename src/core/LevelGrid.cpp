@@ -0,0 +1,121 @@
+#include "LevelGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+void LevelGrid::reset(float newOriginX, float newOriginZ, int newColumns, int newRows, float newCellSize) {
+    originX = newOriginX;
+    originZ = newOriginZ;
+    cellSize = newCellSize;
+    columns = std::max(newColumns, 0);
+    rows = std::max(newRows, 0);
+
+    walls.assign(static_cast<size_t>(columns) * rows, 0);
+}
+
+void LevelGrid::setWall(int column, int row) {
+    if (!inBounds(column, row)) return;
+    walls[static_cast<size_t>(row) * columns + column] = 1;
+}
+
+bool LevelGrid::isWall(int column, int row) const {
+    if (!inBounds(column, row)) return false;
+    return walls[static_cast<size_t>(row) * columns + column] != 0;
+}
+
+glm::ivec2 LevelGrid::cellOf(const glm::vec3& position) const {
+    return {
+        static_cast<int>(std::floor((position.x - originX) / cellSize)),
+        static_cast<int>(std::floor((position.z - originZ) / cellSize))
+    };
+}
+
+glm::vec3 LevelGrid::cellCenter(int column, int row) const {
+    return {
+        originX + (static_cast<float>(column) + 0.5f) * cellSize,
+        0.0f,
+        originZ + (static_cast<float>(row) + 0.5f) * cellSize
+    };
+}
+
+void LevelGrid::cellBounds(int column, int row, glm::vec3& min, glm::vec3& max) const {
+    glm::vec3 center = cellCenter(column, row);
+    float half = cellSize * 0.5f;
+    min = {center.x - half, wallBottom, center.z - half};
+    max = {center.x + half, wallTop, center.z + half};
+}
+
+bool LevelGrid::blocksSpan(int column, int row, float y0, float y1) const {
+    if (!isWall(column, row)) return false;
+    float low = std::min(y0, y1);
+    float high = std::max(y0, y1);
+    return high >= wallBottom && low <= wallTop;
+}
+
+bool LevelGrid::hasLineOfSight(const glm::vec3& start, const glm::vec3& end) const {
+    if (walls.empty()) return true;
+
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    glm::vec3 delta = end - start;
+
+    // Work in grid units, parameterised by t in [0, 1] along the segment
+    float gx = (start.x - originX) / cellSize;
+    float gz = (start.z - originZ) / cellSize;
+    float dx = delta.x / cellSize;
+    float dz = delta.z / cellSize;
+
+    int cx = static_cast<int>(std::floor(gx));
+    int cz = static_cast<int>(std::floor(gz));
+    glm::ivec2 endCell = cellOf(end);
+
+    int stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    int stepZ = dz > 0.0f ? 1 : (dz < 0.0f ? -1 : 0);
+    float tDeltaX = stepX != 0 ? 1.0f / std::fabs(dx) : INF;
+    float tDeltaZ = stepZ != 0 ? 1.0f / std::fabs(dz) : INF;
+    float tMaxX = stepX > 0 ? (static_cast<float>(cx + 1) - gx) / dx
+                : stepX < 0 ? (gx - static_cast<float>(cx)) / -dx
+                : INF;
+    float tMaxZ = stepZ > 0 ? (static_cast<float>(cz + 1) - gz) / dz
+                : stepZ < 0 ? (gz - static_cast<float>(cz)) / -dz
+                : INF;
+
+    // Guard against float drift: never walk more cells than the segment can cross
+    int maxCrossings = std::abs(endCell.x - cx) + std::abs(endCell.y - cz) + 2;
+    float tEnter = 0.0f;
+
+    for (int crossings = 0; crossings <= maxCrossings; crossings++) {
+        float tExit = std::min(std::min(tMaxX, tMaxZ), 1.0f);
+        if (blocksSpan(cx, cz, start.y + delta.y * tEnter, start.y + delta.y * tExit)) {
+            return false;
+        }
+        if (tExit >= 1.0f) break;
+
+        if (std::fabs(tMaxX - tMaxZ) < 1e-6f) {
+            // Passing exactly through a cell corner: touching either neighbour counts
+            float y = start.y + delta.y * tExit;
+            if (blocksSpan(cx + stepX, cz, y, y) || blocksSpan(cx, cz + stepZ, y, y)) {
+                return false;
+            }
+            cx += stepX;
+            cz += stepZ;
+            tMaxX += tDeltaX;
+            tMaxZ += tDeltaZ;
+            crossings++;
+        } else if (tMaxX < tMaxZ) {
+            cx += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            cz += stepZ;
+            tMaxZ += tDeltaZ;
+        }
+        tEnter = tExit;
+    }
+    return true;
+}
+
+void LevelGrid::batchLineOfSight(const glm::vec3* starts, size_t count, const glm::vec3& end, uint8_t* visible) const {
+    for (size_t i = 0; i < count; i++) {
+        visible[i] = hasLineOfSight(starts[i], end) ? 1 : 0;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Wall occupancy of the level's ASCII grid (1 cell = 1 character).
+// Walls fill their whole cell on XZ and span [wallBottom, wallTop] on Y.
+class LevelGrid {
+public:
+    void reset(float originX, float originZ, int columns, int rows, float cellSize = 1.0f);
+    void setWall(int column, int row);
+
+    bool isWall(int column, int row) const;
+    bool inBounds(int column, int row) const { return column >= 0 && row >= 0 && column < columns && row < rows; }
+    glm::ivec2 cellOf(const glm::vec3& position) const;
+    glm::vec3 cellCenter(int column, int row) const;
+    // Box a wall in this cell occupies
+    void cellBounds(int column, int row, glm::vec3& min, glm::vec3& max) const;
+
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+
+    // Exact voxel walk (Amanatides & Woo) from start to end. Blocked if the
+    // segment passes through any wall cell while inside the wall's height.
+    // Passing exactly through a wall's corner counts as blocked.
+    bool hasLineOfSight(const glm::vec3& start, const glm::vec3& end) const;
+
+    // Line of sight from every start to the same end point (e.g. all followers vs the player).
+    // visible[i] is 1 when starts[i] sees end.
+    void batchLineOfSight(const glm::vec3* starts, size_t count, const glm::vec3& end, uint8_t* visible) const;
+
+private:
+    bool blocksSpan(int column, int row, float y0, float y1) const;
+
+    float originX{0.0f};
+    float originZ{0.0f};
+    float cellSize{1.0f};
+    int columns{0};
+    int rows{0};
+    float wallBottom{0.0f};
+    float wallTop{1.0f};
+    std::vector<uint8_t> walls;
+};
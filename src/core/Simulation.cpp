@@ -0,0 +1,428 @@
+#include "Simulation.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include "../assets/levels/AllLevels.h"
+
+Simulation::Simulation(JobSystem& jobSystem) : jobSystem(jobSystem) {
+}
+
+void Simulation::loadLevel(int levelIndex) {
+    if (levelIndex >= Assets::ALL_LEVELS.size()) {
+        std::cout << "Parabéns! Você completou todas as fases!\n";
+        currentLevelIndex = 0; // Reset
+        levelIndex = 0;
+        currentState = GameState::VICTORY;
+        return;
+    }
+
+    std::string levelData = Assets::ALL_LEVELS[levelIndex];
+    std::stringstream file(levelData);
+    
+    obstacles.clear();
+    exits.clear();
+    std::vector<glm::vec3> staticEnemies;
+    std::vector<glm::vec3> followerEnemies;
+    std::vector<glm::ivec2> wallCells; // (column, row), merged into colliders below
+    
+    // Reset Physics State
+    playerVelocityY = 0.0f;
+    isGrounded = false;
+    playerHealth = maxHealth;
+    playerKnockback = glm::vec3(0.0f);
+    currentState = GameState::PLAYING;
+    
+    std::string line;
+    int row = 0;
+    
+    // Grid: Z increases with rows (down), X increases with columns (right)
+    // Map center offset could be added later. For now, top-left of file is (0,0) in world?
+    // Let's center it a bit. Let's say top-left is (-10, -10) or similar.
+    // Or just start at (0,0) and let the player figure it out.
+    // Let's use (x, z) = (col, row). 1 unit per char.
+    
+    float offsetZ = -5.0f; // Center grid roughly
+    float offsetX = -10.0f;
+    
+    int maxCols = 0;
+    while (std::getline(file, line)) {
+        if (line.length() > maxCols) maxCols = line.length();
+        for (int col = 0; col < line.length(); col++) {
+            char c = line[col];
+            float x = static_cast<float>(col) + offsetX;
+            float z = static_cast<float>(row) + offsetZ;
+            
+            if (c == '#') {
+                // Obstacle (1x1x1 per cell, merged with its neighbours after parsing)
+                wallCells.push_back({col, row});
+            } else if (c == 'P') {
+                // Player Start
+                playerPosition = {x, 1.0f, z}; // Slightly above ground
+            } else if (c == 'E') {
+                // Exit Block
+                glm::vec3 min{x - 0.5f, 0.0f, z - 0.5f};
+                glm::vec3 max{x + 0.5f, 1.0f, z + 0.5f};
+                exits.push_back({min, max});
+            } else if (c == 'X') {
+                // Static Enemy
+                staticEnemies.push_back({x, 0.5f, z});
+            } else if (c == 'F') {
+                // Follower Enemy
+                followerEnemies.push_back({x, 0.5f, z});
+            }
+        }
+        row++;
+    }
+
+    enemies.reset(staticEnemies, followerEnemies);
+    enemyBroadphase.reset(enemies.getXData(), enemies.size());
+    flowField.invalidate();
+
+    // Set Boundaries
+    minX = offsetX - 0.5f;
+    maxX = offsetX + static_cast<float>(maxCols) - 0.5f;
+    minZ = offsetZ - 0.5f;
+    maxZ = offsetZ + static_cast<float>(row) - 0.5f;
+
+    mergeWalls(wallCells, maxCols, row);
+
+    // No interpolation across a level change
+    previousPlayerPosition = playerPosition;
+
+    buildSpatialGrids(maxCols, row);
+    levelGeneration++;
+}
+
+bool Simulation::moveAndSlide(const AABB& playerBox, int axis, float delta) {
+    if (delta == 0.0f) return false;
+
+    // Everything the box could touch over the whole step, so fast moves can't tunnel
+    glm::vec3 start = playerPosition;
+    glm::vec3 end = playerPosition;
+    end[axis] += delta;
+    gridCandidates.clear();
+    obstacleGrid.query(glm::min(start, end) + playerBox.min, glm::max(start, end) + playerBox.max, gridCandidates);
+
+    glm::vec3 boxMin = start + playerBox.min;
+    glm::vec3 boxMax = start + playerBox.max;
+    int sideA = (axis + 1) % 3;
+    int sideB = (axis + 2) % 3;
+
+    // Time of impact along one axis: only obstacles overlapping the box on the other
+    // two axes (by more than the skin) and ahead of it in the direction of travel.
+    // Already-penetrating ones are ignored so the box can always move out.
+    float allowed = delta;
+    bool hit = false;
+    for (uint32_t id : gridCandidates) {
+        const AABB& obs = obstacles[id];
+        if (boxMax[sideA] <= obs.min[sideA] + CONTACT_SKIN || boxMin[sideA] >= obs.max[sideA] - CONTACT_SKIN ||
+            boxMax[sideB] <= obs.min[sideB] + CONTACT_SKIN || boxMin[sideB] >= obs.max[sideB] - CONTACT_SKIN) {
+            continue;
+        }
+
+        if (delta > 0.0f && boxMax[axis] <= obs.min[axis] + CONTACT_SKIN) {
+            float gap = std::max(obs.min[axis] - boxMax[axis], 0.0f);
+            if (gap < allowed) {
+                allowed = gap;
+                hit = true;
+            }
+        } else if (delta < 0.0f && boxMin[axis] >= obs.max[axis] - CONTACT_SKIN) {
+            float gap = std::min(obs.max[axis] - boxMin[axis], 0.0f);
+            if (gap > allowed) {
+                allowed = gap;
+                hit = true;
+            }
+        }
+    }
+
+    playerPosition[axis] += allowed;
+    return hit;
+}
+
+void Simulation::mergeWalls(const std::vector<glm::ivec2>& wallCells, int columns, int rows) {
+    std::vector<uint8_t> pending(static_cast<size_t>(columns) * rows, 0);
+    for (const auto& cell : wallCells) {
+        pending[static_cast<size_t>(cell.y) * columns + cell.x] = 1;
+    }
+
+    // Greedy: grow each rectangle as far right as possible, then down while the
+    // whole span below is still unmerged wall. Cuts a level's colliders (and
+    // draws) from one per '#' to roughly one per wall segment.
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < columns; col++) {
+            if (!pending[static_cast<size_t>(row) * columns + col]) continue;
+
+            int width = 1;
+            while (col + width < columns && pending[static_cast<size_t>(row) * columns + col + width]) width++;
+
+            int height = 1;
+            while (row + height < rows) {
+                const uint8_t* span = &pending[static_cast<size_t>(row + height) * columns + col];
+                if (!std::all_of(span, span + width, [](uint8_t wall) { return wall != 0; })) break;
+                height++;
+            }
+
+            for (int r = row; r < row + height; r++) {
+                std::fill_n(&pending[static_cast<size_t>(r) * columns + col], width, 0);
+            }
+
+            glm::vec3 min{minX + static_cast<float>(col), 0.0f, minZ + static_cast<float>(row)};
+            glm::vec3 max{min.x + static_cast<float>(width), 1.0f, min.z + static_cast<float>(height)};
+            obstacles.push_back({min, max});
+        }
+    }
+}
+
+void Simulation::buildSpatialGrids(int columns, int rows) {
+    // One grid cell per level character, aligned with the block AABBs
+    obstacleGrid.reset(minX, minZ, columns, rows);
+    exitGrid.reset(minX, minZ, columns, rows);
+    levelGrid.reset(minX, minZ, columns, rows);
+
+    for (uint32_t i = 0; i < obstacles.size(); i++) {
+        obstacleGrid.insert(i, obstacles[i].min, obstacles[i].max);
+
+        // Merged walls cover several cells
+        glm::ivec2 first = levelGrid.cellOf(obstacles[i].min + glm::vec3(0.5f));
+        glm::ivec2 last = levelGrid.cellOf(obstacles[i].max - glm::vec3(0.5f));
+        for (int row = first.y; row <= last.y; row++) {
+            for (int col = first.x; col <= last.x; col++) {
+                levelGrid.setWall(col, row);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < exits.size(); i++) {
+        exitGrid.insert(i, exits[i].min, exits[i].max);
+    }
+}
+
+void Simulation::takeDamage(float amount, const glm::vec3& sourcePos) {
+    if (currentState != GameState::PLAYING) return;
+    
+    playerHealth -= amount;
+    // std::cout << "Vida: " << playerHealth << "/" << maxHealth << "\n";
+    
+    // Apply Knockback
+    if (amount > 0.0f) {
+        glm::vec3 knockDir = playerPosition - sourcePos;
+        knockDir.y = 0.0f; // Only horizontal knockback for now
+        if (glm::length(knockDir) < 0.001f) {
+            knockDir = glm::vec3(0.0f, 0.0f, 1.0f); // Default dir
+        }
+        playerKnockback = glm::normalize(knockDir) * 18.0f; // Units per second
+    }
+
+    if (playerHealth <= 0) {
+        playerHealth = 0;
+        currentState = GameState::GAME_OVER;
+        std::cout << "GAME OVER! Pressione Enter para tentar novamente.\n";
+    }
+}
+
+void Simulation::restartLevel() {
+    loadLevel(currentLevelIndex);
+}
+
+bool Simulation::checkCollision(const glm::vec3& pos, const AABB& playerBox, const AABB& obstacle) const {
+    // Player AABB at new position 'pos'
+    // Assuming player is 1x1x1 centered at bottom (0.5 extents)
+    // Actually player origin is center so bounds are pos +/- 0.5
+    
+    glm::vec3 pMin = pos - glm::vec3(0.5f);
+    glm::vec3 pMax = pos + glm::vec3(0.5f);
+    
+    // Check overlap
+    bool xOverlap = pMin.x <= obstacle.max.x && pMax.x >= obstacle.min.x;
+    bool yOverlap = pMin.y <= obstacle.max.y && pMax.y >= obstacle.min.y;
+    bool zOverlap = pMin.z <= obstacle.max.z && pMax.z >= obstacle.min.z;
+    
+    return xOverlap && yOverlap && zOverlap;
+}
+
+void Simulation::step(const SimulationInput& input, float dt) {
+    // Snapshot for render interpolation
+    previousPlayerPosition = playerPosition;
+    enemies.savePreviousPositions();
+
+    handleMenus(input);
+    if (currentState != GameState::PLAYING) return;
+
+    updatePhysics(input, dt);
+}
+
+void Simulation::handleMenus(const SimulationInput& input) {
+    bool confirmPressed = input.confirm && !confirmHeld;
+    confirmHeld = input.confirm;
+    if (!confirmPressed) return;
+
+    if (currentState == GameState::MAIN_MENU) {
+        currentState = GameState::PLAYING;
+        restartLevel(); // Force fresh start
+    } else if (currentState == GameState::VICTORY) {
+        currentState = GameState::MAIN_MENU;
+    } else if (currentState == GameState::GAME_OVER) {
+        restartLevel();
+    }
+}
+
+void Simulation::updatePhysics(const SimulationInput& input, float dt) {
+    // Rates are per second (tuned at the old 60 Hz per-frame values)
+    float speed = 3.0f;
+    
+    float yawRad = glm::radians(input.cameraYaw);
+    glm::vec3 forwardDir = glm::normalize(glm::vec3(-sin(yawRad), 0.0f, -cos(yawRad)));
+    glm::vec3 rightDir   = glm::normalize(glm::vec3(cos(yawRad), 0.0f, -sin(yawRad)));
+
+    glm::vec3 moveDir{0.0f};
+
+    if (input.forward) moveDir += forwardDir;
+    if (input.back) moveDir -= forwardDir;
+    if (input.right) moveDir -= rightDir; 
+    if (input.left) moveDir += rightDir; 
+
+    // PHYSICS & MOVEMENT
+    float gravity = 18.0f;
+    float jumpForce = 9.0f;
+    
+    // Apply Friction to knockback
+    if (glm::length(playerKnockback) > 0.06f) {
+        playerKnockback *= std::pow(0.92f, dt * 60.0f); // Decay (0.92 per 60 Hz tick)
+    } else {
+        playerKnockback = glm::vec3(0.0f);
+    }
+
+    // Combine player movement and knockback
+    glm::vec3 finalMove = (moveDir * speed + playerKnockback) * dt;
+
+    // Apply XZ Movement (swept per axis, so blocked motion slides along walls)
+    // Boundaries limit the move itself, so they never push the player into a wall
+    AABB pBox{{-0.5f, -0.5f, -0.5f}, {0.5f, 0.5f, 0.5f}};
+    moveAndSlide(pBox, 0, std::min(std::max(finalMove.x, minX - playerPosition.x), maxX - playerPosition.x));
+    moveAndSlide(pBox, 2, std::min(std::max(finalMove.z, minZ - playerPosition.z), maxZ - playerPosition.z));
+
+    // Apply Gravity / Jump
+    if (input.jump && isGrounded) {
+        playerVelocityY = jumpForce;
+        isGrounded = false;
+    }
+
+    playerVelocityY -= gravity * dt;
+    isGrounded = false;
+
+    // Landing on an obstacle or bumping into one from below stops vertical motion
+    if (moveAndSlide(pBox, 1, playerVelocityY * dt)) {
+        if (playerVelocityY < 0.0f) isGrounded = true;
+        playerVelocityY = 0.0f;
+    }
+
+    // Ground Collision (Y Plane at 0.0)
+    // Player Half-Height is 0.5. So simple ground check is y < 0.5
+    if (playerPosition.y <= 0.5f) {
+        playerPosition.y = 0.5f;
+        playerVelocityY = 0.0f;
+        isGrounded = true;
+    }
+
+    // Enemy Update (Movement & Damage)
+    float enemySpeed = 1.2f;
+    float contactDamage = 30.0f; // Per second of overlap
+
+    // Followers without line of sight walk the shared flow field; it is only
+    // rebuilt when the player enters another cell
+    flowField.update(levelGrid, playerPosition);
+
+    // Follower Logic, phase 1 (parallel): each follower proposes a move from read-only
+    // state: line of sight, vectorized steering and the static obstacle check
+    size_t followerBegin = enemies.getFollowerBegin();
+    size_t followerCount = enemies.getFollowerCount();
+    followerOrigins.resize(followerCount);
+    followerVisibility.resize(followerCount);
+    followerNextX.resize(followerCount);
+    followerNextZ.resize(followerCount);
+    followerMoving.resize(followerCount);
+    threadCandidates.resize(jobSystem.getThreadCount());
+
+    glm::vec3 target = playerPosition;
+    float step = enemySpeed * dt;
+    jobSystem.parallelFor(followerCount, FOLLOWER_GRAIN, [&](size_t begin, size_t end, unsigned thread) {
+        for (size_t k = begin; k < end; k++) {
+            followerOrigins[k] = enemies.position(followerBegin + k);
+        }
+        levelGrid.batchLineOfSight(followerOrigins.data() + begin, end - begin, target, followerVisibility.data() + begin);
+        enemies.steerFollowers(begin, end - begin, target, step, followerVisibility.data(),
+                               followerNextX.data(), followerNextZ.data(), followerMoving.data());
+
+        // Out of sight: follow the path to the player cell by cell
+        for (size_t k = begin; k < end; k++) {
+            glm::vec3 waypoint;
+            if (followerVisibility[k] || !flowField.nextWaypoint(followerOrigins[k], waypoint)) continue;
+
+            glm::vec3 toWaypoint = waypoint - followerOrigins[k];
+            float length = glm::length(toWaypoint);
+            if (length <= 0.0f) continue;
+            glm::vec3 next = length <= step ? waypoint : followerOrigins[k] + toWaypoint * (step / length);
+            followerNextX[k] = next.x;
+            followerNextZ[k] = next.z;
+            followerMoving[k] = 1;
+        }
+
+        auto& candidates = threadCandidates[thread];
+        for (size_t k = begin; k < end; k++) {
+            if (!followerMoving[k]) continue;
+
+            glm::vec3 nextEnemyMin{followerNextX[k] - EnemyPool::HALF_EXTENT, 0.0f, followerNextZ[k] - EnemyPool::HALF_EXTENT};
+            glm::vec3 nextEnemyMax{followerNextX[k] + EnemyPool::HALF_EXTENT, 1.0f, followerNextZ[k] + EnemyPool::HALF_EXTENT};
+            candidates.clear();
+            obstacleGrid.query(nextEnemyMin, nextEnemyMax, candidates);
+            for (uint32_t id : candidates) {
+                const auto& obs = obstacles[id];
+                if (nextEnemyMax.x > obs.min.x && nextEnemyMin.x < obs.max.x &&
+                    nextEnemyMax.z > obs.min.z && nextEnemyMin.z < obs.max.z) {
+                    followerMoving[k] = 0;
+                    break;
+                }
+            }
+        }
+    });
+
+    // Phase 2 (serial, in follower order): enemy-enemy separation sees the moves applied
+    // before it, so the outcome never depends on thread timing
+    for (size_t k = 0; k < followerCount; k++) {
+        if (!followerMoving[k]) continue;
+
+        size_t i = followerBegin + k;
+        glm::vec3 nextEnemyPos{followerNextX[k], followerOrigins[k].y, followerNextZ[k]};
+
+        // Enemy-Enemy Collision (only neighbours within the separation distance on X)
+        float separation = 0.8f; // Slightly less than 1.0 to avoid sticking
+        bool enemyCollided = enemyBroadphase.anyWithin(static_cast<uint32_t>(i), nextEnemyPos.x, separation, [&](uint32_t j) {
+            return glm::distance(nextEnemyPos, enemies.position(j)) < separation;
+        });
+
+        if (!enemyCollided) {
+            enemies.setPosition(i, nextEnemyPos);
+            enemyBroadphase.update(static_cast<uint32_t>(i), nextEnemyPos.x);
+        }
+    }
+
+    // Damage Check (vectorized overlap of every enemy box against the player)
+    enemyHits.clear();
+    enemies.overlapping(playerPosition + pBox.min, playerPosition + pBox.max, enemyHits);
+    for (uint32_t id : enemyHits) {
+        takeDamage(contactDamage * dt, enemies.position(id)); // Pass position for knockback
+    }
+
+    // Check Exit Collision
+    gridCandidates.clear();
+    exitGrid.query(playerPosition + pBox.min, playerPosition + pBox.max, gridCandidates);
+    for (uint32_t id : gridCandidates) {
+        if (checkCollision(playerPosition, pBox, exits[id])) {
+            std::cout << "Fase completada! Carregando próxima fase...\n";
+            currentLevelIndex++;
+            loadLevel(currentLevelIndex);
+            break;
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "SpatialGrid.h"
+#include "LevelGrid.h"
+#include "FlowField.h"
+#include "EnemyPool.h"
+#include "SweepAndPrune.h"
+#include "JobSystem.h"
+
+enum class GameState { MAIN_MENU, PLAYING, GAME_OVER, VICTORY };
+
+struct AABB {
+    glm::vec3 min;
+    glm::vec3 max;
+};
+
+// Input for one tick, already decoupled from the window (GLFW keys or a script)
+struct SimulationInput {
+    bool forward{false};
+    bool back{false};
+    bool left{false};
+    bool right{false};
+    bool jump{false};
+    bool confirm{false}; // Enter: leaves the menu / game over / victory screens
+    float cameraYaw{0.0f}; // Degrees; movement is relative to the camera
+};
+
+// Game logic only: level loading, player physics, enemies, damage and exits.
+// Has no window or Vulkan dependency, so it can be stepped headless.
+class Simulation {
+public:
+    explicit Simulation(JobSystem& jobSystem);
+
+    void loadLevel(int levelIndex);
+    void restartLevel();
+
+    // Advances one fixed tick
+    void step(const SimulationInput& input, float dt);
+
+    GameState getState() const { return currentState; }
+    int getLevelIndex() const { return currentLevelIndex; }
+    // Bumped on every level (re)load, so renderers know when static geometry changed
+    uint32_t getLevelGeneration() const { return levelGeneration; }
+    float getPlayerHealth() const { return playerHealth; }
+    float getMaxHealth() const { return maxHealth; }
+    const glm::vec3& getPlayerPosition() const { return playerPosition; }
+    const glm::vec3& getPreviousPlayerPosition() const { return previousPlayerPosition; }
+    const std::vector<AABB>& getObstacles() const { return obstacles; }
+    const std::vector<AABB>& getExits() const { return exits; }
+    const LevelGrid& getLevelGrid() const { return levelGrid; }
+    const EnemyPool& getEnemies() const { return enemies; }
+
+private:
+    void handleMenus(const SimulationInput& input);
+    void updatePhysics(const SimulationInput& input, float dt);
+    // Moves the player by delta along one axis (0 = X, 1 = Y, 2 = Z), stopping at the
+    // first obstacle in the way. Returns true if it was stopped.
+    bool moveAndSlide(const AABB& playerBox, int axis, float delta);
+    bool checkCollision(const glm::vec3& pos, const AABB& playerBox, const AABB& obstacle) const;
+    void mergeWalls(const std::vector<glm::ivec2>& wallCells, int columns, int rows);
+    void buildSpatialGrids(int columns, int rows);
+    void takeDamage(float amount, const glm::vec3& sourcePos = glm::vec3(0.0f));
+
+    JobSystem& jobSystem;
+
+    GameState currentState{GameState::MAIN_MENU};
+    bool confirmHeld{false}; // Enter acts on press, not while held
+
+    // Game State
+    float playerHealth{100.0f};
+    float maxHealth{100.0f};
+    glm::vec3 playerPosition{0.0f, 1.0f, 0.0f}; // Start slightly above ground
+    float playerVelocityY{0.0f};
+    bool isGrounded{false};
+    glm::vec3 playerKnockback{0.0f};
+    glm::vec3 previousPlayerPosition{0.0f, 1.0f, 0.0f}; // Last tick, for render interpolation
+
+    // Physics State
+    std::vector<AABB> obstacles; // Wall cells merged into maximal rectangles
+    std::vector<AABB> exits;
+    EnemyPool enemies; // 'X' then 'F', stored as arrays
+    SweepAndPrune enemyBroadphase; // Enemies sorted along X for enemy-enemy separation
+    SpatialGrid obstacleGrid;
+    SpatialGrid exitGrid;
+    std::vector<uint32_t> gridCandidates; // Scratch for grid queries
+    LevelGrid levelGrid;
+    FlowField flowField; // Paths to the player for followers without line of sight
+
+    // Per-tick follower scratch (indexed within the follower range)
+    std::vector<glm::vec3> followerOrigins;
+    std::vector<uint8_t> followerVisibility;
+    std::vector<float> followerNextX;
+    std::vector<float> followerNextZ;
+    std::vector<uint8_t> followerMoving;
+    std::vector<uint32_t> enemyHits;
+    std::vector<std::vector<uint32_t>> threadCandidates; // Grid query scratch per job thread
+    static constexpr size_t FOLLOWER_GRAIN = 256;
+    static constexpr float CONTACT_SKIN = 1e-3f; // Touching within this counts as contact, not overlap
+    float minX{0}, maxX{0}, minZ{0}, maxZ{0};
+    int currentLevelIndex = 0;
+    uint32_t levelGeneration{0};
+};
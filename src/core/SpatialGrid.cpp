@@ -0,0 +1,74 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float CELL_EPSILON = 1e-4f;
+}
+
+void SpatialGrid::reset(float newOriginX, float newOriginZ, int newColumns, int newRows, float newCellSize) {
+    originX = newOriginX;
+    originZ = newOriginZ;
+    cellSize = newCellSize;
+    inverseCellSize = 1.0f / newCellSize;
+    columns = std::max(newColumns, 1);
+    rows = std::max(newRows, 1);
+
+    cells.clear();
+    cells.resize(static_cast<size_t>(columns) * rows);
+}
+
+void SpatialGrid::clear() {
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+}
+
+int SpatialGrid::clampColumn(int x) const {
+    return std::clamp(x, 0, columns - 1);
+}
+
+int SpatialGrid::clampRow(int z) const {
+    return std::clamp(z, 0, rows - 1);
+}
+
+SpatialGrid::CellRange SpatialGrid::cellRange(const glm::vec3& min, const glm::vec3& max, float pad) const {
+    CellRange range;
+    range.x0 = clampColumn(static_cast<int>(std::floor((min.x - pad - originX) * inverseCellSize)));
+    range.z0 = clampRow(static_cast<int>(std::floor((min.z - pad - originZ) * inverseCellSize)));
+    range.x1 = clampColumn(static_cast<int>(std::floor((max.x + pad - originX) * inverseCellSize)));
+    range.z1 = clampRow(static_cast<int>(std::floor((max.z + pad - originZ) * inverseCellSize)));
+    // Degenerate boxes shrunk past themselves still belong to one cell
+    range.x1 = std::max(range.x1, range.x0);
+    range.z1 = std::max(range.z1, range.z0);
+    return range;
+}
+
+void SpatialGrid::insert(uint32_t id, const glm::vec3& min, const glm::vec3& max) {
+    if (cells.empty()) return;
+
+    CellRange range = cellRange(min, max, -CELL_EPSILON);
+    for (int z = range.z0; z <= range.z1; z++) {
+        for (int x = range.x0; x <= range.x1; x++) {
+            cells[static_cast<size_t>(z) * columns + x].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) const {
+    if (cells.empty()) return;
+
+    size_t first = out.size();
+    CellRange range = cellRange(min, max, CELL_EPSILON);
+    for (int z = range.z0; z <= range.z1; z++) {
+        for (int x = range.x0; x <= range.x1; x++) {
+            const auto& cell = cells[static_cast<size_t>(z) * columns + x];
+            out.insert(out.end(), cell.begin(), cell.end());
+        }
+    }
+
+    // Large boxes span several cells; keep each id once and in id order
+    // so results match the old linear scans.
+    std::sort(out.begin() + first, out.end());
+    out.erase(std::unique(out.begin() + first, out.end()), out.end());
+}
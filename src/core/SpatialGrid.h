@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Uniform grid over the XZ plane of a level (1 cell = 1 level character by default).
+// Stores ids of AABBs per cell so overlap queries only touch nearby cells.
+// Y is ignored here; callers still run the exact AABB test on the candidates.
+class SpatialGrid {
+public:
+    void reset(float originX, float originZ, int columns, int rows, float cellSize = 1.0f);
+    void clear();
+
+    void insert(uint32_t id, const glm::vec3& min, const glm::vec3& max);
+
+    // Appends the ids of every AABB whose cells touch [min, max].
+    // Appended ids are sorted and unique, so callers see them in insertion-id order.
+    // Const and scratch-free: safe to call from several threads at once.
+    void query(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) const;
+
+private:
+    struct CellRange {
+        int x0, z0, x1, z1;
+    };
+
+    // pad > 0 grows the box (queries must see touching neighbours),
+    // pad < 0 shrinks it (an AABB exactly on cell borders belongs to one cell only)
+    CellRange cellRange(const glm::vec3& min, const glm::vec3& max, float pad) const;
+    int clampColumn(int x) const;
+    int clampRow(int z) const;
+
+    float originX{0.0f};
+    float originZ{0.0f};
+    float cellSize{1.0f};
+    float inverseCellSize{1.0f};
+    int columns{0};
+    int rows{0};
+    std::vector<std::vector<uint32_t>> cells;
+};
@@ -0,0 +1,36 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+#include <numeric>
+
+void SweepAndPrune::reset(const float* newKeys, size_t count) {
+    keys.assign(newKeys, newKeys + count);
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+    });
+
+    rank.resize(count);
+    for (size_t slot = 0; slot < count; slot++) {
+        rank[order[slot]] = static_cast<uint32_t>(slot);
+    }
+}
+
+void SweepAndPrune::update(uint32_t id, float key) {
+    keys[id] = key;
+    size_t slot = rank[id];
+
+    // Bubble toward the new position; bodies rarely pass more than a neighbour per tick
+    while (slot > 0 && keys[order[slot - 1]] > key) {
+        order[slot] = order[slot - 1];
+        rank[order[slot]] = static_cast<uint32_t>(slot);
+        slot--;
+    }
+    while (slot + 1 < order.size() && keys[order[slot + 1]] < key) {
+        order[slot] = order[slot + 1];
+        rank[order[slot]] = static_cast<uint32_t>(slot);
+        slot++;
+    }
+    order[slot] = id;
+    rank[id] = static_cast<uint32_t>(slot);
+}
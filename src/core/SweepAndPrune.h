@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sort-and-sweep broadphase along X for dynamic bodies.
+// Bodies stay sorted by their X key; moving a body re-sorts it incrementally
+// (insertion step), which is O(1) amortized since bodies move a little per tick.
+class SweepAndPrune {
+public:
+    void reset(const float* keys, size_t count);
+    void update(uint32_t id, float key);
+
+    size_t size() const { return order.size(); }
+    float key(uint32_t id) const { return keys[id]; }
+
+    // Calls test(other) for every body other than 'self' whose key lies within
+    // 'radius' of x, walking outward from self's slot. Returns true as soon as a
+    // test returns true. x is expected to be near self's own key (a proposed move).
+    template <typename Test>
+    bool anyWithin(uint32_t self, float x, float radius, Test&& test) const {
+        size_t slot = rank[self];
+        for (size_t s = slot; s-- > 0;) {
+            uint32_t other = order[s];
+            if (keys[other] <= x - radius) break;
+            if (test(other)) return true;
+        }
+        for (size_t s = slot + 1; s < order.size(); s++) {
+            uint32_t other = order[s];
+            if (keys[other] >= x + radius) break;
+            if (test(other)) return true;
+        }
+        return false;
+    }
+
+private:
+    std::vector<float> keys;      // Indexed by body id
+    std::vector<uint32_t> order;  // Body ids sorted by key
+    std::vector<uint32_t> rank;   // Body id -> slot in 'order'
+};
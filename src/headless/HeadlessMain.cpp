@@ -0,0 +1,172 @@
+// Runs the simulation without a window or Vulkan device, feeding it a scripted
+// input stream, and reports ticks per second plus the final state.
+//
+// Usage: Platformer3DHeadless [--ticks N] [--hz rate] [--level i] [--threads n] [--script file]
+//
+// Script format, one segment per line ('#' starts a comment):
+//   <ticks> [W] [A] [S] [D] [JUMP] [ENTER] [yaw=<degrees>]
+// Each segment holds its keys for <ticks> ticks; the script repeats until N ticks ran.
+// Segment lengths are written for 60 Hz and scaled when --hz differs.
+#include "core/Simulation.h"
+#include "core/JobSystem.h"
+#include "assets/levels/AllLevels.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr float SCRIPT_HZ = 60.0f;
+
+    struct ScriptSegment {
+        int ticks{1};
+        SimulationInput input{};
+    };
+
+    // Walks around the level, jumping now and then, with a few camera turns
+    const char* DEFAULT_SCRIPT =
+        "60 W\n"
+        "30 W D\n"
+        "60 W JUMP yaw=90\n"
+        "45 S A\n"
+        "60 W yaw=180\n"
+        "20 D JUMP\n"
+        "60 W yaw=270\n"
+        "1 ENTER\n";
+
+    bool parseScript(std::istream& in, std::vector<ScriptSegment>& segments) {
+        std::string line;
+        int lineNumber = 0;
+        float yaw = 0.0f; // Sticky between segments, like the mouse
+        while (std::getline(in, line)) {
+            lineNumber++;
+            size_t comment = line.find('#');
+            if (comment != std::string::npos) line.erase(comment);
+
+            std::stringstream tokens(line);
+            ScriptSegment segment;
+            if (!(tokens >> segment.ticks)) continue; // Blank line
+            if (segment.ticks <= 0) {
+                std::cerr << "Script linha " << lineNumber << ": numero de ticks invalido\n";
+                return false;
+            }
+
+            std::string token;
+            while (tokens >> token) {
+                if (token == "W") segment.input.forward = true;
+                else if (token == "S") segment.input.back = true;
+                else if (token == "A") segment.input.left = true;
+                else if (token == "D") segment.input.right = true;
+                else if (token == "JUMP") segment.input.jump = true;
+                else if (token == "ENTER") segment.input.confirm = true;
+                else if (token.rfind("yaw=", 0) == 0) yaw = std::strtof(token.c_str() + 4, nullptr);
+                else {
+                    std::cerr << "Script linha " << lineNumber << ": comando desconhecido '" << token << "'\n";
+                    return false;
+                }
+            }
+            segment.input.cameraYaw = yaw;
+            segments.push_back(segment);
+        }
+        return !segments.empty();
+    }
+
+    const char* stateName(GameState state) {
+        switch (state) {
+            case GameState::MAIN_MENU: return "MAIN_MENU";
+            case GameState::PLAYING: return "PLAYING";
+            case GameState::GAME_OVER: return "GAME_OVER";
+            case GameState::VICTORY: return "VICTORY";
+        }
+        return "?";
+    }
+}
+
+int main(int argc, char** argv) {
+    long long totalTicks = 60 * 60;
+    float hz = SCRIPT_HZ;
+    int level = 0;
+    unsigned threads = 0;
+    std::string scriptPath;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--ticks" && hasValue) totalTicks = std::atoll(argv[++i]);
+        else if (arg == "--hz" && hasValue) hz = std::strtof(argv[++i], nullptr);
+        else if (arg == "--level" && hasValue) level = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (arg == "--script" && hasValue) scriptPath = argv[++i];
+        else {
+            std::cerr << "Uso: " << argv[0] << " [--ticks N] [--hz taxa] [--level i] [--threads n] [--script arquivo]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (hz <= 0.0f) {
+        std::cerr << "Taxa invalida: " << hz << "\n";
+        return EXIT_FAILURE;
+    }
+
+    if (level < 0 || level >= static_cast<int>(Assets::ALL_LEVELS.size())) {
+        std::cerr << "Fase invalida: " << level << " (existem " << Assets::ALL_LEVELS.size() << ")\n";
+        return EXIT_FAILURE;
+    }
+
+    std::vector<ScriptSegment> script;
+    if (scriptPath.empty()) {
+        std::stringstream in(DEFAULT_SCRIPT);
+        parseScript(in, script);
+    } else {
+        std::ifstream in(scriptPath);
+        if (!in.is_open()) {
+            std::cerr << "Falha ao abrir script: " << scriptPath << "\n";
+            return EXIT_FAILURE;
+        }
+        if (!parseScript(in, script)) {
+            std::cerr << "Falha ao ler script: " << scriptPath << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Keep the scripted route the same length in seconds at any tick rate
+    for (auto& segment : script) {
+        segment.ticks = std::max(1, static_cast<int>(std::lround(segment.ticks * hz / SCRIPT_HZ)));
+    }
+    float dt = 1.0f / hz;
+
+    // threads counts the calling thread too
+    JobSystem jobSystem(threads > 0 ? threads - 1 : 0);
+    Simulation simulation(jobSystem);
+    simulation.loadLevel(level);
+
+    size_t segment = 0;
+    int segmentTick = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long long tick = 0; tick < totalTicks; tick++) {
+        simulation.step(script[segment].input, dt);
+        if (++segmentTick >= script[segment].ticks) {
+            segmentTick = 0;
+            segment = (segment + 1) % script.size();
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const glm::vec3& player = simulation.getPlayerPosition();
+    const EnemyPool& enemies = simulation.getEnemies();
+    std::printf("threads:   %u\n", jobSystem.getThreadCount());
+    std::printf("ticks:     %lld at %.0f Hz in %.3f s (%.0f ticks/s, %.1fx real time)\n", totalTicks, hz, seconds,
+                seconds > 0.0 ? totalTicks / seconds : 0.0, seconds > 0.0 ? totalTicks * dt / seconds : 0.0);
+    std::printf("state:     %s, level %d, health %.2f/%.0f\n", stateName(simulation.getState()),
+                simulation.getLevelIndex(), simulation.getPlayerHealth(), simulation.getMaxHealth());
+    std::printf("player:    %.4f %.4f %.4f\n", player.x, player.y, player.z);
+    std::printf("enemies:   %zu (%zu followers)\n", enemies.size(), enemies.getFollowerCount());
+    std::printf("colliders: %zu walls, %zu exits\n", simulation.getObstacles().size(), simulation.getExits().size());
+    return EXIT_SUCCESS;
+}
@@ -1,9 +1,42 @@
 #include "core/Engine.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char** argv) {
+    EngineConfig config;
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--culling") == 0 && hasValue) {
+            const char* mode = argv[++i];
+            if (std::strcmp(mode, "cpu") == 0) config.culling = CullingMode::CPU;
+            else if (std::strcmp(mode, "gpu") == 0) config.culling = CullingMode::GPU;
+            else {
+                std::cerr << "Modo de culling invalido: " << mode << " (use cpu ou gpu)\n";
+                return EXIT_FAILURE;
+            }
+        } else if (std::strcmp(argv[i], "--present-mode") == 0 && hasValue) {
+            const char* mode = argv[++i];
+            if (std::strcmp(mode, "fifo") == 0) config.presentMode = PresentMode::FIFO;
+            else if (std::strcmp(mode, "mailbox") == 0) config.presentMode = PresentMode::MAILBOX;
+            else if (std::strcmp(mode, "immediate") == 0) config.presentMode = PresentMode::IMMEDIATE;
+            else {
+                std::cerr << "Present mode invalido: " << mode << " (use fifo, mailbox ou immediate)\n";
+                return EXIT_FAILURE;
+            }
+        } else if (std::strcmp(argv[i], "--gpu-profile-log") == 0 && hasValue) {
+            config.gpuProfileLogInterval = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--vma-stats") == 0 && hasValue) {
+            config.memoryStatsPath = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--culling cpu|gpu] [--present-mode fifo|mailbox|immediate] [--gpu-profile-log segundos]"
+                      << " [--vma-stats arquivo]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
     try {
-        Engine engine;
+        Engine engine(config);
         engine.init();
         engine.run();
     } catch (const std::exception& e) {
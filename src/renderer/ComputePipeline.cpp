@@ -0,0 +1,44 @@
+#include "ComputePipeline.h"
+#include "Pipeline.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+
+ComputePipeline::ComputePipeline(VulkanContext* ctx, const std::string& compPath, VkPipelineLayout layout)
+    : context(ctx), pipelineLayout(layout) {
+
+    auto compCode = Pipeline::readFile(compPath);
+
+    VkShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    moduleInfo.codeSize = compCode.size();
+    moduleInfo.pCode = reinterpret_cast<const uint32_t*>(compCode.data());
+
+    if (vkCreateShaderModule(context->getDevice(), &moduleInfo, nullptr, &compShaderModule) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar Shader Module!");
+    }
+
+    VkPipelineShaderStageCreateInfo compShaderStageInfo{};
+    compShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    compShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    compShaderStageInfo.module = compShaderModule;
+    compShaderStageInfo.pName = "main";
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = compShaderStageInfo;
+    pipelineInfo.layout = pipelineLayout;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    if (vkCreateComputePipelines(context->getDevice(), context->getPipelineCache(), 1, &pipelineInfo, nullptr, &computePipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar pipeline de compute!");
+    }
+}
+
+ComputePipeline::~ComputePipeline() {
+    vkDestroyShaderModule(context->getDevice(), compShaderModule, nullptr);
+    vkDestroyPipeline(context->getDevice(), computePipeline, nullptr);
+}
+
+void ComputePipeline::bind(VkCommandBuffer commandBuffer) {
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
+}
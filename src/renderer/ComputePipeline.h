@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <string>
+
+class VulkanContext;
+
+// Single compute shader stage, the compute counterpart of Pipeline.
+// The layout is created (and destroyed) by the owner, as with Pipeline.
+class ComputePipeline {
+public:
+    ComputePipeline(VulkanContext* context, const std::string& compPath, VkPipelineLayout layout);
+    ~ComputePipeline();
+
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+    void bind(VkCommandBuffer commandBuffer);
+
+    VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+
+private:
+    VulkanContext* context;
+    VkPipeline computePipeline{VK_NULL_HANDLE};
+    VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
+    VkShaderModule compShaderModule{VK_NULL_HANDLE};
+};
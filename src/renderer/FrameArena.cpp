@@ -0,0 +1,115 @@
+#include "FrameArena.h"
+#include "VulkanContext.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    // alignment must be a power of two, which all Vulkan offset limits are
+    VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+FrameArena::FrameArena(VulkanContext* ctx, uint32_t frameCount, VkDeviceSize blockSize, VkBufferUsageFlags bufferUsage)
+    : context(ctx), usage(bufferUsage), frames(frameCount) {
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &properties);
+    if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+        minAlignment = std::max(minAlignment, properties.limits.minUniformBufferOffsetAlignment);
+    }
+    if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
+        minAlignment = std::max(minAlignment, properties.limits.minStorageBufferOffsetAlignment);
+    }
+
+    for (auto& frame : frames) {
+        frame.block = createBlock(blockSize);
+    }
+}
+
+FrameArena::~FrameArena() {
+    for (auto& frame : frames) {
+        destroyBlock(frame.block);
+        for (auto& block : frame.retired) {
+            destroyBlock(block);
+        }
+    }
+}
+
+void FrameArena::begin(uint32_t frame) {
+    currentFrame = frame;
+    FrameData& data = frames[frame];
+    for (auto& block : data.retired) {
+        destroyBlock(block);
+    }
+    data.retired.clear();
+    data.offset = 0;
+}
+
+FrameArena::Slice FrameArena::allocate(VkDeviceSize size, VkDeviceSize alignment) {
+    FrameData& frame = frames[currentFrame];
+    alignment = std::max(alignment, minAlignment);
+    VkDeviceSize offset = alignUp(frame.offset, alignment);
+
+    if (offset + size > frame.block.size) {
+        frame.retired.push_back(frame.block);
+        frame.block = createBlock(std::max(frame.block.size * 2, size));
+        offset = 0;
+    }
+    frame.offset = offset + size;
+
+    Slice slice;
+    slice.buffer = frame.block.buffer;
+    slice.offset = offset;
+    slice.size = size;
+    slice.data = static_cast<char*>(frame.block.mapped) + offset;
+    slice.blockSerial = frame.block.serial;
+    return slice;
+}
+
+FrameArena::Slice FrameArena::upload(const void* data, VkDeviceSize size, VkDeviceSize alignment) {
+    Slice slice = allocate(size, alignment);
+    if (size > 0) memcpy(slice.data, data, static_cast<size_t>(size));
+    return slice;
+}
+
+void FrameArena::flush() {
+    // No-ops on coherent memory
+    FrameData& frame = frames[currentFrame];
+    for (auto& block : frame.retired) {
+        vmaFlushAllocation(context->getAllocator(), block.allocation, 0, VK_WHOLE_SIZE);
+    }
+    if (frame.offset > 0) {
+        vmaFlushAllocation(context->getAllocator(), frame.block.allocation, 0, frame.offset);
+    }
+}
+
+FrameArena::Block FrameArena::createBlock(VkDeviceSize size) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    Block block;
+    VmaAllocationInfo allocationInfo{};
+    if (vmaCreateBuffer(context->getAllocator(), &bufferInfo, &allocInfo, &block.buffer, &block.allocation, &allocationInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar bloco da arena de frame!");
+    }
+    context->nameAllocation(block.allocation, "Frame arena");
+    block.mapped = allocationInfo.pMappedData;
+    block.size = size;
+    block.serial = nextSerial++;
+    return block;
+}
+
+void FrameArena::destroyBlock(Block& block) {
+    if (block.buffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(context->getAllocator(), block.buffer, block.allocation);
+    }
+    block = Block{};
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+class VulkanContext;
+
+// Linear upload memory for data rebuilt every frame (instances, uniforms, indirect
+// arguments). Each frame slot owns a persistently mapped block; begin() rewinds it
+// once the slot's fence has signaled and allocate() hands out aligned slices by
+// bumping an offset, with no Vulkan calls. A block that runs out is replaced by one
+// twice as big; the old one stays alive until the slot comes around again, since
+// slices already handed out this frame still point into it. The next begin() destroys
+// it, which invalidates any recorded command buffer that still references it: callers
+// that cache recordings must compare Slice::blockSerial, never the VkBuffer handle
+// (the driver may hand the same value to a later block).
+class FrameArena {
+public:
+    struct Slice {
+        VkBuffer buffer{VK_NULL_HANDLE};
+        VkDeviceSize offset{0};
+        VkDeviceSize size{0};
+        void* data{nullptr}; // Write-only: host memory may be uncached
+        uint64_t blockSerial{0}; // Unique per block ever created; changes when the block is replaced
+    };
+
+    // usage is the union of everything slices will be bound as
+    FrameArena(VulkanContext* context, uint32_t frameCount, VkDeviceSize blockSize, VkBufferUsageFlags usage);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Must not be called while the GPU may still read the slot's slices
+    void begin(uint32_t frame);
+
+    // Offsets are also aligned to the device's uniform/storage offset limits when usage has them
+    Slice allocate(VkDeviceSize size, VkDeviceSize alignment = 16);
+    Slice upload(const void* data, VkDeviceSize size, VkDeviceSize alignment = 16);
+
+    // Makes this frame's writes visible to the device; call once before submitting
+    void flush();
+
+private:
+    struct Block {
+        VkBuffer buffer{VK_NULL_HANDLE};
+        VmaAllocation allocation{VK_NULL_HANDLE};
+        void* mapped{nullptr};
+        VkDeviceSize size{0};
+        uint64_t serial{0};
+    };
+    struct FrameData {
+        Block block;
+        std::vector<Block> retired; // Outgrown this frame, freed on the next begin
+        VkDeviceSize offset{0};
+    };
+
+    Block createBlock(VkDeviceSize size);
+    void destroyBlock(Block& block);
+
+    VulkanContext* context;
+    VkBufferUsageFlags usage;
+    VkDeviceSize minAlignment{1};
+    std::vector<FrameData> frames;
+    uint32_t currentFrame{0};
+    uint64_t nextSerial{1};
+};
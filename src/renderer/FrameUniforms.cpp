@@ -0,0 +1,115 @@
+#include "FrameUniforms.h"
+#include "VulkanContext.h"
+#include "../core/Frustum.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+FrameUniforms::FrameUniforms(VulkanContext* ctx, uint32_t frameCount) : context(ctx), frames(frameCount) {
+    createLayout();
+    createBuffers();
+    createDescriptors();
+}
+
+FrameUniforms::~FrameUniforms() {
+    for (auto& frame : frames) {
+        vmaDestroyBuffer(context->getAllocator(), frame.buffer, frame.allocation);
+    }
+    vkDestroyDescriptorPool(context->getDevice(), descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(context->getDevice(), descriptorSetLayout, nullptr);
+}
+
+void FrameUniforms::createLayout() {
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+
+    if (vkCreateDescriptorSetLayout(context->getDevice(), &setLayoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar descriptor set layout!");
+    }
+}
+
+void FrameUniforms::createBuffers() {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = sizeof(FrameUniformData);
+    bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    for (auto& frame : frames) {
+        VmaAllocationInfo allocationInfo{};
+        if (vmaCreateBuffer(context->getAllocator(), &bufferInfo, &allocInfo, &frame.buffer, &frame.allocation, &allocationInfo) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar Uniform Buffer!");
+        }
+        context->nameAllocation(frame.allocation, "Frame uniforms");
+        frame.mapped = allocationInfo.pMappedData;
+    }
+}
+
+void FrameUniforms::createDescriptors() {
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSize.descriptorCount = static_cast<uint32_t>(frames.size());
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = static_cast<uint32_t>(frames.size());
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(context->getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar descriptor pool!");
+    }
+
+    std::vector<VkDescriptorSetLayout> layouts(frames.size(), descriptorSetLayout);
+    std::vector<VkDescriptorSet> sets(frames.size());
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    allocInfo.pSetLayouts = layouts.data();
+
+    if (vkAllocateDescriptorSets(context->getDevice(), &allocInfo, sets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao alocar descriptor sets!");
+    }
+
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].descriptorSet = sets[i];
+
+        VkDescriptorBufferInfo bufferInfo{frames[i].buffer, 0, sizeof(FrameUniformData)};
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = sets[i];
+        write.dstBinding = 0;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        write.pBufferInfo = &bufferInfo;
+        vkUpdateDescriptorSets(context->getDevice(), 1, &write, 0, nullptr);
+    }
+}
+
+void FrameUniforms::update(uint32_t frame, const glm::mat4& projectionView, const Frustum& frustum) {
+    FrameUniformData data{};
+    data.projectionView = projectionView;
+    std::copy(frustum.getPlanes(), frustum.getPlanes() + 6, data.frustumPlanes);
+
+    FrameData& frameData = frames[frame];
+    memcpy(frameData.mapped, &data, sizeof(data));
+    vmaFlushAllocation(context->getAllocator(), frameData.allocation, 0, sizeof(data)); // No-op on coherent memory
+}
+
+void FrameUniforms::bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t frame) const {
+    vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, 0, 1, &frames[frame].descriptorSet, 0, nullptr);
+}
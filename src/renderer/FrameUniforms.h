@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <glm/glm.hpp>
+
+class VulkanContext;
+class Frustum;
+
+// std140 layout of the FrameUniforms block (simple_shader.vert, cull.comp)
+struct FrameUniformData {
+    glm::mat4 projectionView;
+    glm::vec4 frustumPlanes[6]; // Same order as Frustum::getPlanes
+};
+
+// Per-frame-slot camera data in persistently mapped uniform buffers, one
+// descriptor set per slot at set 0 of both the graphics and the cull pipelines.
+// Recorded command buffers only reference the set, so moving the camera is a
+// buffer write and never forces a re-record.
+class FrameUniforms {
+public:
+    FrameUniforms(VulkanContext* context, uint32_t frameCount);
+    ~FrameUniforms();
+
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+    VkDescriptorSetLayout getDescriptorSetLayout() const { return descriptorSetLayout; }
+
+    // Must not be called while the GPU may still read the slot's buffer
+    void update(uint32_t frame, const glm::mat4& projectionView, const Frustum& frustum);
+    void bind(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t frame) const;
+
+private:
+    struct FrameData {
+        VkBuffer buffer{VK_NULL_HANDLE};
+        VmaAllocation allocation{VK_NULL_HANDLE};
+        void* mapped{nullptr};
+        VkDescriptorSet descriptorSet{VK_NULL_HANDLE};
+    };
+
+    void createLayout();
+    void createBuffers();
+    void createDescriptors();
+
+    VulkanContext* context;
+    VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE};
+    VkDescriptorPool descriptorPool{VK_NULL_HANDLE};
+    std::vector<FrameData> frames;
+};
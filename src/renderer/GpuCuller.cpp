@@ -0,0 +1,268 @@
+#include "GpuCuller.h"
+#include "ComputePipeline.h"
+#include "VulkanContext.h"
+#include "FrameUniforms.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+    constexpr size_t MIN_CAPACITY = 64;
+    constexpr uint32_t STORAGE_BINDINGS = 2; // Draw bounds, draw commands
+}
+
+GpuCuller::GpuCuller(VulkanContext* ctx, const FrameUniforms& uniforms, uint32_t frameCount)
+    : context(ctx), frameUniforms(&uniforms), frames(frameCount) {
+    // 1 without multiDrawIndirect, so draw() then issues one indirect draw per section
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &properties);
+    maxDrawIndirectCount = std::max(properties.limits.maxDrawIndirectCount, 1u);
+
+    createLayout();
+    pipeline = std::make_unique<ComputePipeline>(context, "shaders/cull.comp.spv", pipelineLayout);
+    createDescriptors();
+    allocateDrawBuffers(MIN_CAPACITY);
+}
+
+GpuCuller::~GpuCuller() {
+    VkDevice device = context->getDevice();
+    for (auto& frame : frames) {
+        destroyBuffer(frame.drawCommands);
+    }
+    destroyBuffer(drawBounds);
+    destroyBuffer(drawInstances);
+    pipeline.reset();
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+}
+
+void GpuCuller::createLayout() {
+    VkDescriptorSetLayoutBinding bindings[STORAGE_BINDINGS]{};
+    for (uint32_t i = 0; i < STORAGE_BINDINGS; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = STORAGE_BINDINGS;
+    setLayoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(context->getDevice(), &setLayoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar descriptor set layout!");
+    }
+
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(PushConstants);
+
+    VkDescriptorSetLayout setLayouts[] = {frameUniforms->getDescriptorSetLayout(), descriptorSetLayout};
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 2;
+    pipelineLayoutInfo.pSetLayouts = setLayouts;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(context->getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar pipeline layout!");
+    }
+}
+
+void GpuCuller::createDescriptors() {
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = STORAGE_BINDINGS * static_cast<uint32_t>(frames.size());
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = static_cast<uint32_t>(frames.size());
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(context->getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar descriptor pool!");
+    }
+
+    std::vector<VkDescriptorSetLayout> layouts(frames.size(), descriptorSetLayout);
+    std::vector<VkDescriptorSet> sets(frames.size());
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = descriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    allocInfo.pSetLayouts = layouts.data();
+
+    if (vkAllocateDescriptorSets(context->getDevice(), &allocInfo, sets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao alocar descriptor sets!");
+    }
+    for (size_t i = 0; i < frames.size(); i++) {
+        frames[i].descriptorSet = sets[i];
+    }
+}
+
+GpuCuller::Buffer GpuCuller::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const char* error) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    Buffer result;
+    if (vmaCreateBuffer(context->getAllocator(), &bufferInfo, &allocInfo, &result.buffer, &result.allocation, nullptr) != VK_SUCCESS) {
+        throw std::runtime_error(error);
+    }
+    context->nameAllocation(result.allocation, "GPU culling");
+    return result;
+}
+
+void GpuCuller::destroyBuffer(Buffer& buffer) {
+    if (buffer.buffer != VK_NULL_HANDLE) {
+        vmaDestroyBuffer(context->getAllocator(), buffer.buffer, buffer.allocation);
+    }
+    buffer = Buffer{};
+}
+
+void GpuCuller::allocateDrawBuffers(size_t drawCapacity) {
+    destroyBuffer(drawBounds);
+    drawBounds = createBuffer(sizeof(DrawBounds) * drawCapacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              "Falha ao criar buffer de limites dos draws!");
+    destroyBuffer(drawInstances);
+    drawInstances = createBuffer(sizeof(InstanceData) * drawCapacity, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                 "Falha ao criar buffer de instancias dos draws!");
+    for (auto& frame : frames) {
+        destroyBuffer(frame.drawCommands);
+        frame.drawCommands = createBuffer(sizeof(VkDrawIndexedIndirectCommand) * drawCapacity,
+                                          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                          "Falha ao criar buffer de draw indireto!");
+    }
+    capacity = drawCapacity;
+    writeDescriptors();
+}
+
+void GpuCuller::writeDescriptors() {
+    for (auto& frame : frames) {
+        VkDescriptorBufferInfo bufferInfos[STORAGE_BINDINGS] = {
+            {drawBounds.buffer, 0, VK_WHOLE_SIZE},
+            {frame.drawCommands.buffer, 0, VK_WHOLE_SIZE},
+        };
+
+        VkWriteDescriptorSet writes[STORAGE_BINDINGS]{};
+        for (uint32_t i = 0; i < STORAGE_BINDINGS; i++) {
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = frame.descriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorCount = 1;
+            writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+        vkUpdateDescriptorSets(context->getDevice(), STORAGE_BINDINGS, writes, 0, nullptr);
+    }
+}
+
+void GpuCuller::setDraws(const std::vector<CullDraw>& draws) {
+    vkDeviceWaitIdle(context->getDevice());
+
+    if (draws.size() > capacity) {
+        size_t newCapacity = capacity;
+        while (newCapacity < draws.size()) newCapacity *= 2;
+        allocateDrawBuffers(newCapacity);
+    }
+    drawCount = static_cast<uint32_t>(draws.size());
+    if (draws.empty()) return;
+
+    VkDeviceSize boundsSize = sizeof(DrawBounds) * draws.size();
+    VkDeviceSize instancesSize = sizeof(InstanceData) * draws.size();
+
+    // One staging buffer holds bounds then instances for a single transfer
+    VkBufferCreateInfo stagingInfo{};
+    stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingInfo.size = boundsSize + instancesSize;
+    stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    stagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    Buffer staging;
+    VmaAllocationInfo stagingAllocation{};
+    if (vmaCreateBuffer(context->getAllocator(), &stagingInfo, &stagingAllocInfo, &staging.buffer, &staging.allocation, &stagingAllocation) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar Staging Buffer!");
+    }
+    context->nameAllocation(staging.allocation, "Staging");
+
+    auto* bounds = static_cast<DrawBounds*>(stagingAllocation.pMappedData);
+    auto* instances = reinterpret_cast<InstanceData*>(static_cast<char*>(stagingAllocation.pMappedData) + boundsSize);
+    for (size_t i = 0; i < draws.size(); i++) {
+        const CullDraw& draw = draws[i];
+        DrawBounds entry{};
+        entry.center = glm::vec4((draw.min + draw.max) * 0.5f, 0.0f);
+        entry.extent = glm::vec4((draw.max - draw.min) * 0.5f, 0.0f);
+        entry.firstIndex = draw.firstIndex;
+        entry.indexCount = draw.indexCount;
+        memcpy(&bounds[i], &entry, sizeof(entry));
+        memcpy(&instances[i], &draw.instance, sizeof(InstanceData));
+    }
+    vmaFlushAllocation(context->getAllocator(), staging.allocation, 0, VK_WHOLE_SIZE);
+
+    context->immediateSubmit([&](VkCommandBuffer commandBuffer) {
+        VkBufferCopy boundsCopy{0, 0, boundsSize};
+        vkCmdCopyBuffer(commandBuffer, staging.buffer, drawBounds.buffer, 1, &boundsCopy);
+        VkBufferCopy instancesCopy{boundsSize, 0, instancesSize};
+        vkCmdCopyBuffer(commandBuffer, staging.buffer, drawInstances.buffer, 1, &instancesCopy);
+
+        // Make the copies visible to the cull pass and vertex input in later submissions
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    });
+
+    destroyBuffer(staging);
+}
+
+void GpuCuller::cull(VkCommandBuffer commandBuffer, uint32_t frame) {
+    if (drawCount == 0) return;
+    FrameData& frameData = frames[frame];
+
+    // Every command is rewritten, so no reset is needed. The slot's fence
+    // guarantees the previous indirect read of this buffer has finished.
+    PushConstants pushConstants{};
+    pushConstants.drawCount = drawCount;
+
+    pipeline->bind(commandBuffer);
+    frameUniforms->bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, frame);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 1, 1, &frameData.descriptorSet, 0, nullptr);
+    vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pushConstants);
+    vkCmdDispatch(commandBuffer, (drawCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    // The draw reads the commands
+    VkMemoryBarrier cullBarrier{};
+    cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+                         0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+}
+
+void GpuCuller::draw(VkCommandBuffer commandBuffer, uint32_t frame, Mesh& mesh) {
+    if (drawCount == 0) return;
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 1, 1, &drawInstances.buffer, &offset);
+    for (uint32_t first = 0; first < drawCount; first += maxDrawIndirectCount) {
+        uint32_t count = std::min(drawCount - first, maxDrawIndirectCount);
+        mesh.drawIndirect(commandBuffer, frames[frame].drawCommands.buffer, sizeof(VkDrawIndexedIndirectCommand) * first, count);
+    }
+}
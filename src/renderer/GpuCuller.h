@@ -0,0 +1,97 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+#include <glm/glm.hpp>
+#include "Mesh.h"
+
+class VulkanContext;
+class ComputePipeline;
+class FrameUniforms;
+
+// One indexed draw of a baked mesh (e.g. a LevelMesh section), culled as a whole
+struct CullDraw {
+    glm::vec3 min;
+    glm::vec3 max;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    InstanceData instance; // Transform and color of the draw
+};
+
+// GPU-driven culling of static draws. Their bounds live in a device-local
+// storage buffer; every frame a compute pass tests them against the frustum
+// planes in FrameUniforms (set 0) and writes one VkDrawIndexedIndirectCommand per draw (0 instances when
+// culled) into the frame slot's buffer, issued by indirect calls of up to
+// maxDrawIndirectCount draws each (a single call on most devices), so recording
+// costs the same no matter how large the level is.
+// Requires drawIndirectFirstInstance; without multiDrawIndirect the limit is 1 draw per call.
+class GpuCuller {
+public:
+    GpuCuller(VulkanContext* context, const FrameUniforms& frameUniforms, uint32_t frameCount);
+    ~GpuCuller();
+
+    GpuCuller(const GpuCuller&) = delete;
+    GpuCuller& operator=(const GpuCuller&) = delete;
+
+    // Replaces the draws (on level load). Waits for the device to go idle,
+    // since frames in flight may still read the previous set.
+    void setDraws(const std::vector<CullDraw>& draws);
+    uint32_t getDrawCount() const { return drawCount; }
+
+    // Records the cull pass for a frame slot; must be outside a render pass.
+    // Reads the slot's frustum when it runs, so a recorded pass stays valid as the camera moves.
+    void cull(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    // Issues the frame slot's draws against mesh (already bound); binds its own instances at binding 1
+    void draw(VkCommandBuffer commandBuffer, uint32_t frame, Mesh& mesh);
+
+private:
+    struct Buffer {
+        VkBuffer buffer{VK_NULL_HANDLE};
+        VmaAllocation allocation{VK_NULL_HANDLE};
+    };
+
+    // std430 layout of DrawBounds in cull.comp
+    struct DrawBounds {
+        glm::vec4 center;
+        glm::vec4 extent;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t padding[2];
+    };
+
+    struct FrameData {
+        Buffer drawCommands; // One VkDrawIndexedIndirectCommand per draw
+        VkDescriptorSet descriptorSet{VK_NULL_HANDLE};
+    };
+
+    struct PushConstants {
+        uint32_t drawCount;
+    };
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64; // local_size_x in cull.comp
+
+    void createLayout();
+    void createDescriptors();
+    Buffer createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, const char* error);
+    void destroyBuffer(Buffer& buffer);
+    void allocateDrawBuffers(size_t drawCapacity);
+    void writeDescriptors();
+
+    VulkanContext* context;
+    const FrameUniforms* frameUniforms;
+
+    VkDescriptorSetLayout descriptorSetLayout{VK_NULL_HANDLE}; // Set 1; set 0 is FrameUniforms
+    VkPipelineLayout pipelineLayout{VK_NULL_HANDLE};
+    VkDescriptorPool descriptorPool{VK_NULL_HANDLE};
+    std::unique_ptr<ComputePipeline> pipeline;
+
+    Buffer drawBounds;    // DrawBounds per draw, read by the cull pass
+    Buffer drawInstances; // InstanceData per draw, bound at binding 1 (firstInstance = draw index)
+    size_t capacity{0};
+    uint32_t drawCount{0};
+    uint32_t maxDrawIndirectCount{1}; // Per vkCmdDrawIndexedIndirect; draw() splits into batches
+    std::vector<FrameData> frames;
+};
@@ -0,0 +1,126 @@
+#include "GpuProfiler.h"
+#include "VulkanContext.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+GpuProfiler::GpuProfiler(VulkanContext* ctx, uint32_t frameCount)
+    : context(ctx), queryPools(frameCount, VK_NULL_HANDLE), submitted(frameCount, false) {
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &properties);
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(context->getPhysicalDevice(), &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(context->getPhysicalDevice(), &familyCount, families.data());
+    uint32_t validBits = families[context->getGraphicsQueueFamily()].timestampValidBits;
+
+    supported = validBits > 0 && timestampPeriod > 0.0f;
+    if (!supported) {
+        std::cerr << "Timestamps nao suportados na fila grafica; profiler de GPU desativado\n";
+        return;
+    }
+    if (validBits < 64) timestampMask = (1ull << validBits) - 1;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_REGIONS * 2;
+
+    for (auto& pool : queryPools) {
+        if (vkCreateQueryPool(context->getDevice(), &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar query pool de timestamps!");
+        }
+    }
+    results.resize(MAX_REGIONS * 2 * 2);
+}
+
+GpuProfiler::~GpuProfiler() {
+    for (auto pool : queryPools) {
+        vkDestroyQueryPool(context->getDevice(), pool, nullptr);
+    }
+}
+
+uint32_t GpuProfiler::addRegion(std::string name) {
+    if (regions.size() >= MAX_REGIONS) {
+        throw std::runtime_error("Regioes demais no profiler de GPU!");
+    }
+    regions.push_back({std::move(name)});
+    return static_cast<uint32_t>(regions.size() - 1);
+}
+
+void GpuProfiler::reset(VkCommandBuffer commandBuffer, uint32_t frame) {
+    if (!supported) return;
+    vkCmdResetQueryPool(commandBuffer, queryPools[frame], 0, MAX_REGIONS * 2);
+}
+
+void GpuProfiler::begin(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t region) {
+    if (!supported) return;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPools[frame], region * 2);
+}
+
+void GpuProfiler::end(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t region) {
+    if (!supported) return;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPools[frame], region * 2 + 1);
+}
+
+void GpuProfiler::collect(uint32_t frame) {
+    if (!supported || !submitted[frame] || regions.empty()) return;
+    submitted[frame] = false;
+
+    // No WAIT flag: the fence already covers the queries, and regions that were
+    // not recorded this frame just report unavailable
+    uint32_t queryCount = static_cast<uint32_t>(regions.size() * 2);
+    VkResult result = vkGetQueryPoolResults(context->getDevice(), queryPools[frame], 0, queryCount,
+                                            sizeof(uint64_t) * 2 * queryCount, results.data(), sizeof(uint64_t) * 2,
+                                            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (result != VK_SUCCESS && result != VK_NOT_READY) return;
+
+    for (size_t i = 0; i < regions.size(); i++) {
+        const uint64_t* begin = &results[i * 4];
+        const uint64_t* end = &results[i * 4 + 2];
+        if (begin[1] == 0 || end[1] == 0) continue;
+
+        uint64_t ticks = ((end[0] & timestampMask) - (begin[0] & timestampMask)) & timestampMask;
+        Region& region = regions[i];
+        region.samples[region.count % WINDOW] = ticks * timestampPeriod * 1e-6;
+        region.count++;
+    }
+}
+
+std::vector<GpuProfiler::RegionStats> GpuProfiler::getStats() const {
+    std::vector<RegionStats> stats;
+    stats.reserve(regions.size());
+    for (const auto& region : regions) {
+        RegionStats entry;
+        entry.name = region.name;
+        entry.samples = std::min(region.count, WINDOW);
+        if (entry.samples > 0) {
+            auto first = region.samples.begin();
+            auto last = first + static_cast<std::ptrdiff_t>(entry.samples);
+            auto [minIt, maxIt] = std::minmax_element(first, last);
+            double sum = 0.0;
+            for (auto it = first; it != last; ++it) sum += *it;
+            entry.minMs = *minIt;
+            entry.maxMs = *maxIt;
+            entry.avgMs = sum / static_cast<double>(entry.samples);
+        }
+        stats.push_back(std::move(entry));
+    }
+    return stats;
+}
+
+std::string GpuProfiler::formatStats() const {
+    std::string line;
+    char buffer[128];
+    for (const auto& entry : getStats()) {
+        if (entry.samples == 0) continue;
+        std::snprintf(buffer, sizeof(buffer), "%s%s %.3f/%.3f/%.3f", line.empty() ? "" : " | ",
+                      entry.name.c_str(), entry.minMs, entry.avgMs, entry.maxMs);
+        line += buffer;
+    }
+    return line;
+}
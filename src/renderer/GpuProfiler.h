@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+class VulkanContext;
+
+// Timestamp queries around named regions of a frame (passes, draw categories).
+// Every frame slot has its own query pool; its results are read right after
+// the slot's fence has signaled, so readback never waits on the GPU. Each
+// region keeps a rolling window of samples for min/avg/max.
+// Regions may be recorded in primary or secondary command buffers; a region
+// not recorded in a frame simply yields no sample for it.
+class GpuProfiler {
+public:
+    static constexpr uint32_t MAX_REGIONS = 32;
+    static constexpr size_t WINDOW = 120; // Samples per region in the rolling stats
+
+    struct RegionStats {
+        std::string name;
+        double minMs{0.0};
+        double avgMs{0.0};
+        double maxMs{0.0};
+        size_t samples{0}; // In the window; 0 if the region never ran
+    };
+
+    GpuProfiler(VulkanContext* context, uint32_t frameCount);
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // False if the graphics queue has no timestamp support; every call is then a no-op
+    bool isSupported() const { return supported; }
+
+    // Registers a region and returns its id for begin/end
+    uint32_t addRegion(std::string name);
+
+    // Clears the slot's queries; record once per submission, outside a render pass,
+    // before any begin/end of that slot
+    void reset(VkCommandBuffer commandBuffer, uint32_t frame);
+    void begin(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t region);
+    void end(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t region);
+
+    // Call after submitting the slot's commands
+    void markSubmitted(uint32_t frame) { submitted[frame] = true; }
+
+    // Reads the slot's last results into the rolling stats; the slot's fence must have signaled
+    void collect(uint32_t frame);
+
+    std::vector<RegionStats> getStats() const;
+
+    // One line, e.g. "frame 1.20/1.31/1.80 | ground 0.05/0.06/0.09", in ms min/avg/max
+    std::string formatStats() const;
+
+private:
+    struct Region {
+        std::string name;
+        std::array<double, WINDOW> samples{};
+        size_t count{0}; // Total samples taken; the window holds the last WINDOW
+    };
+
+    VulkanContext* context;
+    bool supported{false};
+    double timestampPeriod{1.0}; // Nanoseconds per tick
+    uint64_t timestampMask{~0ull}; // Only timestampValidBits are meaningful
+
+    std::vector<VkQueryPool> queryPools; // Per frame slot, two queries per region
+    std::vector<bool> submitted;         // Per frame slot: results pending
+    std::vector<Region> regions;
+    std::vector<uint64_t> results; // Readback scratch: value, availability per query
+};
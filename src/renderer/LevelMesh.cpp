@@ -0,0 +1,124 @@
+#include "LevelMesh.h"
+#include "../core/LevelGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // Half floats hold every multiple of 0.5 exactly up to this magnitude
+    constexpr float MAX_HALF_COORDINATE = 1024.0f;
+
+    constexpr uint8_t EMPTY = 0;
+    constexpr uint8_t WALL = 1;
+    constexpr uint8_t EXIT = 2;
+
+    // Side faces: neighbour offset on the grid and the face normal
+    struct Side {
+        int column, row;
+        glm::vec3 normal;
+    };
+    const Side SIDES[4] = {
+        { 1,  0, { 1.0f, 0.0f,  0.0f}},
+        {-1,  0, {-1.0f, 0.0f,  0.0f}},
+        { 0,  1, { 0.0f, 0.0f,  1.0f}},
+        { 0, -1, { 0.0f, 0.0f, -1.0f}},
+    };
+}
+
+LevelMesh::LevelMesh(VulkanContext* context, const LevelGrid& grid, const std::vector<glm::ivec2>& exitCells) {
+    int columns = grid.getColumns();
+    int rows = grid.getRows();
+
+    std::vector<uint8_t> cells(static_cast<size_t>(columns) * rows, EMPTY);
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            if (grid.isWall(column, row)) cells[row * columns + column] = WALL;
+        }
+    }
+    for (const auto& cell : exitCells) {
+        if (grid.inBounds(cell.x, cell.y)) cells[cell.y * columns + cell.x] = EXIT;
+    }
+    auto solid = [&](int column, int row) {
+        return grid.inBounds(column, row) && cells[row * columns + column] != EMPTY;
+    };
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    // Quad from 4 corners in order around the face
+    auto addFace = [&](const glm::vec3 (&corners)[4], const glm::vec3& normal) {
+        uint32_t base = static_cast<uint32_t>(vertices.size());
+        for (const auto& corner : corners) {
+            vertices.push_back(Vertex::make(corner, normal));
+        }
+        for (uint32_t index : {0u, 1u, 2u, 0u, 2u, 3u}) {
+            indices.push_back(base + index);
+        }
+        faceCount++;
+    };
+
+    for (int chunkRow = 0; chunkRow < rows; chunkRow += CHUNK_SIZE) {
+        for (int chunkColumn = 0; chunkColumn < columns; chunkColumn += CHUNK_SIZE) {
+            for (Material material : {Material::WALL, Material::EXIT}) {
+                uint8_t kind = material == Material::WALL ? WALL : EXIT;
+
+                Section section{};
+                section.min = glm::vec3(std::numeric_limits<float>::max());
+                section.max = glm::vec3(std::numeric_limits<float>::lowest());
+                section.firstIndex = static_cast<uint32_t>(indices.size());
+                section.material = material;
+
+                int rowEnd = std::min(chunkRow + CHUNK_SIZE, rows);
+                int columnEnd = std::min(chunkColumn + CHUNK_SIZE, columns);
+                for (int row = chunkRow; row < rowEnd; row++) {
+                    for (int column = chunkColumn; column < columnEnd; column++) {
+                        if (cells[row * columns + column] != kind) continue;
+
+                        glm::vec3 min, max;
+                        grid.cellBounds(column, row, min, max);
+                        if (std::fabs(min.x) > MAX_HALF_COORDINATE || std::fabs(max.x) > MAX_HALF_COORDINATE ||
+                            std::fabs(min.z) > MAX_HALF_COORDINATE || std::fabs(max.z) > MAX_HALF_COORDINATE) {
+                            throw std::runtime_error("Fase grande demais para o formato de vertice!");
+                        }
+
+                        // Top face is always visible; all blocks share the same height
+                        addFace({{min.x, max.y, min.z}, {max.x, max.y, min.z}, {max.x, max.y, max.z}, {min.x, max.y, max.z}},
+                                {0.0f, 1.0f, 0.0f});
+
+                        for (const auto& side : SIDES) {
+                            if (solid(column + side.column, row + side.row)) continue;
+
+                            // Wall plane on the side's axis, spanning the other horizontal axis and Y
+                            if (side.column != 0) {
+                                float x = side.column > 0 ? max.x : min.x;
+                                addFace({{x, min.y, min.z}, {x, max.y, min.z}, {x, max.y, max.z}, {x, min.y, max.z}}, side.normal);
+                            } else {
+                                float z = side.row > 0 ? max.z : min.z;
+                                addFace({{min.x, min.y, z}, {min.x, max.y, z}, {max.x, max.y, z}, {max.x, min.y, z}}, side.normal);
+                            }
+                        }
+
+                        section.min = glm::min(section.min, min);
+                        section.max = glm::max(section.max, max);
+                    }
+                }
+
+                section.indexCount = static_cast<uint32_t>(indices.size()) - section.firstIndex;
+                if (section.indexCount > 0) sections.push_back(section);
+            }
+        }
+    }
+
+    if (!vertices.empty()) {
+        mesh = std::make_unique<Mesh>(context, vertices, indices, "Level");
+    }
+}
+
+void LevelMesh::bind(VkCommandBuffer commandBuffer) {
+    mesh->bind(commandBuffer);
+}
+
+void LevelMesh::drawSection(VkCommandBuffer commandBuffer, size_t section, uint32_t firstInstance) {
+    mesh->drawRange(commandBuffer, sections[section].firstIndex, sections[section].indexCount, 1, firstInstance);
+}
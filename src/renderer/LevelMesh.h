@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include "Mesh.h"
+
+class VulkanContext;
+class LevelGrid;
+
+// Static scenery (walls and exits) baked once per level into a single mesh,
+// split into sections of CHUNK_SIZE x CHUNK_SIZE cells, one per material.
+// Faces between two solid cells and bottom faces (resting on the ground) are
+// dropped. Each section is drawn with one call, so the cost follows the number
+// of visible chunks instead of the number of blocks.
+class LevelMesh {
+public:
+    static constexpr int CHUNK_SIZE = 16;
+
+    enum class Material : uint8_t { WALL, EXIT };
+
+    struct Section {
+        glm::vec3 min;
+        glm::vec3 max;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        Material material;
+    };
+
+    LevelMesh(VulkanContext* context, const LevelGrid& grid, const std::vector<glm::ivec2>& exitCells);
+
+    const std::vector<Section>& getSections() const { return sections; }
+    size_t getFaceCount() const { return faceCount; }
+
+    // Nothing to bind or draw for a level without walls or exits
+    bool empty() const { return sections.empty(); }
+    void bind(VkCommandBuffer commandBuffer);
+    Mesh& getMesh() { return *mesh; }
+    void drawSection(VkCommandBuffer commandBuffer, size_t section, uint32_t firstInstance);
+
+private:
+    std::unique_ptr<Mesh> mesh;
+    std::vector<Section> sections;
+    size_t faceCount{0};
+};
@@ -0,0 +1,85 @@
+#include "MemoryBudget.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    double toMiB(VkDeviceSize bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+MemoryBudget::MemoryBudget(VmaAllocator vmaAllocator, bool hasDriverBudget)
+    : allocator(vmaAllocator), driverBudget(hasDriverBudget) {
+    const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+    vmaGetMemoryProperties(allocator, &properties);
+    warned.assign(properties->memoryHeapCount, false);
+}
+
+void MemoryBudget::setFrameIndex(uint32_t frameIndex) {
+    vmaSetCurrentFrameIndex(allocator, frameIndex);
+}
+
+std::vector<MemoryBudget::HeapUsage> MemoryBudget::getHeapUsage() const {
+    const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+    vmaGetMemoryProperties(allocator, &properties);
+
+    std::vector<VmaBudget> budgets(properties->memoryHeapCount);
+    vmaGetHeapBudgets(allocator, budgets.data());
+
+    std::vector<HeapUsage> heaps(properties->memoryHeapCount);
+    for (uint32_t i = 0; i < properties->memoryHeapCount; i++) {
+        heaps[i].heap = i;
+        heaps[i].deviceLocal = (properties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        heaps[i].usage = budgets[i].usage;
+        heaps[i].budget = budgets[i].budget;
+        heaps[i].allocationBytes = budgets[i].statistics.allocationBytes;
+        heaps[i].blockBytes = budgets[i].statistics.blockBytes;
+    }
+    return heaps;
+}
+
+std::string MemoryBudget::formatHeapUsage() const {
+    std::string text;
+    char entry[128];
+    for (const auto& heap : getHeapUsage()) {
+        std::snprintf(entry, sizeof(entry), "%sheap %u%s %.1f/%.1f MiB (VMA %.1f em blocos de %.1f)", text.empty() ? "" : ", ",
+                      heap.heap, heap.deviceLocal ? " (GPU)" : "", toMiB(heap.usage), toMiB(heap.budget),
+                      toMiB(heap.allocationBytes), toMiB(heap.blockBytes));
+        text += entry;
+    }
+    return text;
+}
+
+bool MemoryBudget::checkBudget() {
+    bool overWarning = false;
+    for (const auto& heap : getHeapUsage()) {
+        if (heap.budget == 0) continue;
+        double fraction = static_cast<double>(heap.usage) / static_cast<double>(heap.budget);
+        if (fraction >= WARN_FRACTION) {
+            overWarning = true;
+            if (!warned[heap.heap]) {
+                std::cerr << "Aviso: heap " << heap.heap << " de memoria da GPU em " << static_cast<int>(fraction * 100.0)
+                          << "% do orcamento (" << toMiB(heap.usage) << " de " << toMiB(heap.budget) << " MiB)\n";
+                warned[heap.heap] = true;
+            }
+        } else if (fraction < REARM_FRACTION) {
+            warned[heap.heap] = false;
+        }
+    }
+    return overWarning;
+}
+
+bool MemoryBudget::dumpJson(const std::string& path) const {
+    char* json = nullptr;
+    vmaBuildStatsString(allocator, &json, VK_TRUE);
+
+    std::ofstream file(path, std::ios::binary);
+    bool written = file.is_open() && (file << json) && file.good();
+    vmaFreeStatsString(allocator, json);
+
+    if (!written) {
+        std::cerr << "Falha ao gravar estatisticas de memoria: " << path << "\n";
+    }
+    return written;
+}
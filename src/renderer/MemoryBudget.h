@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+// GPU memory instrumentation on top of the VMA allocator: per-heap usage versus
+// budget, a warning before a heap runs over, and the full JSON statistics dump.
+// With VK_EXT_memory_budget the numbers come from the driver (including other
+// processes); without it VMA estimates the budget as 80% of the heap.
+// Allocations are tagged by subsystem with vmaSetAllocationName, so the dump
+// shows which one a block belongs to.
+class MemoryBudget {
+public:
+    static constexpr double WARN_FRACTION = 0.9;   // Warn at this share of a heap's budget
+    static constexpr double REARM_FRACTION = 0.85; // ... again only after dropping below this
+
+    struct HeapUsage {
+        uint32_t heap{0};
+        bool deviceLocal{false};
+        VkDeviceSize usage{0};           // Whole process (driver-reported with the extension)
+        VkDeviceSize budget{0};
+        VkDeviceSize allocationBytes{0}; // Handed out by VMA
+        VkDeviceSize blockBytes{0};      // Reserved by VMA in VkDeviceMemory blocks
+    };
+
+    MemoryBudget(VmaAllocator allocator, bool driverBudget);
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    bool hasDriverBudget() const { return driverBudget; }
+
+    // Once per frame: lets VMA refresh the driver's budget numbers
+    void setFrameIndex(uint32_t frameIndex);
+
+    std::vector<HeapUsage> getHeapUsage() const;
+    std::string formatHeapUsage() const;
+
+    // Logs every heap that crossed WARN_FRACTION since the last call; true while any is above it
+    bool checkBudget();
+
+    // Writes vmaBuildStatsString (detailed, with allocation names) to path
+    bool dumpJson(const std::string& path) const;
+
+private:
+    VmaAllocator allocator;
+    bool driverBudget;
+    std::vector<bool> warned; // Per heap, until it drops below REARM_FRACTION
+};
@@ -1,7 +1,35 @@
 #include "Mesh.h"
 #include "VulkanContext.h"
+#include <glm/gtc/packing.hpp>
+#include <cmath>
 #include <cstring>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+    // Folds the unit sphere onto the [-1, 1] square (octahedral mapping)
+    glm::vec2 encodeOctahedral(glm::vec3 n) {
+        n /= std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+        glm::vec2 e{n.x, n.y};
+        if (n.z < 0.0f) {
+            glm::vec2 signs{e.x >= 0.0f ? 1.0f : -1.0f, e.y >= 0.0f ? 1.0f : -1.0f};
+            e = glm::vec2{(1.0f - std::fabs(n.y)) * signs.x, (1.0f - std::fabs(n.x)) * signs.y};
+        }
+        return e;
+    }
+}
+
+Vertex Vertex::make(const glm::vec3& position, const glm::vec3& normal) {
+    Vertex vertex{};
+    vertex.position[0] = glm::packHalf1x16(position.x);
+    vertex.position[1] = glm::packHalf1x16(position.y);
+    vertex.position[2] = glm::packHalf1x16(position.z);
+    vertex.position[3] = glm::packHalf1x16(1.0f);
+    vertex.normal = glm::packSnorm2x16(encodeOctahedral(normal));
+    return vertex;
+}
 
 VkVertexInputBindingDescription Vertex::getBindingDescription() {
     VkVertexInputBindingDescription bindingDescription{};
@@ -12,66 +40,170 @@ VkVertexInputBindingDescription Vertex::getBindingDescription() {
 }
 
 std::vector<VkVertexInputAttributeDescription> Vertex::getAttributeDescriptions() {
-    std::vector<VkVertexInputAttributeDescription> attributeDescriptions(3);
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions(2);
 
     // Position
     attributeDescriptions[0].binding = 0;
     attributeDescriptions[0].location = 0;
-    attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+    attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_SFLOAT;
     attributeDescriptions[0].offset = offsetof(Vertex, position);
 
     // Normal
     attributeDescriptions[1].binding = 0;
     attributeDescriptions[1].location = 1;
-    attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+    attributeDescriptions[1].format = VK_FORMAT_R16G16_SNORM;
     attributeDescriptions[1].offset = offsetof(Vertex, normal);
 
+    return attributeDescriptions;
+}
+
+VkVertexInputBindingDescription InstanceData::getBindingDescription() {
+    VkVertexInputBindingDescription bindingDescription{};
+    bindingDescription.binding = 1;
+    bindingDescription.stride = sizeof(InstanceData);
+    bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+    return bindingDescription;
+}
+
+std::vector<VkVertexInputAttributeDescription> InstanceData::getAttributeDescriptions() {
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions(3);
+
+    // Position
+    attributeDescriptions[0].binding = 1;
+    attributeDescriptions[0].location = 2;
+    attributeDescriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+    attributeDescriptions[0].offset = offsetof(InstanceData, position);
+
+    // Scale
+    attributeDescriptions[1].binding = 1;
+    attributeDescriptions[1].location = 3;
+    attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+    attributeDescriptions[1].offset = offsetof(InstanceData, scale);
+
     // Color
-    attributeDescriptions[2].binding = 0;
-    attributeDescriptions[2].location = 2;
+    attributeDescriptions[2].binding = 1;
+    attributeDescriptions[2].location = 4;
     attributeDescriptions[2].format = VK_FORMAT_R32G32B32_SFLOAT;
-    attributeDescriptions[2].offset = offsetof(Vertex, color);
+    attributeDescriptions[2].offset = offsetof(InstanceData, color);
 
     return attributeDescriptions;
 }
 
-Mesh::Mesh(VulkanContext* ctx, const std::vector<Vertex>& vertices) : context(ctx), vertexCount(static_cast<uint32_t>(vertices.size())) {
-    createVertexBuffer(vertices);
+Mesh::Mesh(VulkanContext* ctx, const std::vector<Vertex>& vertices, const char* name) : context(ctx) {
+    std::vector<Vertex> uniqueVertices;
+    std::vector<uint32_t> indices;
+    deduplicate(vertices, uniqueVertices, indices);
+    createBuffers(uniqueVertices, indices, name);
+}
+
+Mesh::Mesh(VulkanContext* ctx, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const char* name) : context(ctx) {
+    createBuffers(vertices, indices, name);
 }
 
 Mesh::~Mesh() {
     vmaDestroyBuffer(context->getAllocator(), vertexBuffer.buffer, vertexBuffer.allocation);
+    vmaDestroyBuffer(context->getAllocator(), indexBuffer.buffer, indexBuffer.allocation);
 }
 
 void Mesh::bind(VkCommandBuffer commandBuffer) {
     VkBuffer buffers[] = {vertexBuffer.buffer};
     VkDeviceSize offsets[] = {0};
     vkCmdBindVertexBuffers(commandBuffer, 0, 1, buffers, offsets);
+    vkCmdBindIndexBuffer(commandBuffer, indexBuffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+}
+
+void Mesh::draw(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance) {
+    vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, 0, 0, firstInstance);
 }
 
-void Mesh::draw(VkCommandBuffer commandBuffer) {
-    vkCmdDraw(commandBuffer, vertexCount, 1, 0, 0);
+void Mesh::drawRange(VkCommandBuffer commandBuffer, uint32_t firstIndex, uint32_t rangeIndexCount, uint32_t instanceCount, uint32_t firstInstance) {
+    vkCmdDrawIndexed(commandBuffer, rangeIndexCount, instanceCount, firstIndex, 0, firstInstance);
 }
 
-void Mesh::createVertexBuffer(const std::vector<Vertex>& vertices) {
-    VkDeviceSize bufferSize = sizeof(vertices[0]) * vertices.size();
+void Mesh::drawIndirect(VkCommandBuffer commandBuffer, VkBuffer indirectBuffer, VkDeviceSize offset, uint32_t drawCount) {
+    vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, offset, drawCount, sizeof(VkDrawIndexedIndirectCommand));
+}
 
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = bufferSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+void Mesh::deduplicate(const std::vector<Vertex>& triangleList, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    // Vertex has no padding bytes, so its bytes are a valid key
+    static_assert(sizeof(Vertex) == 4 * sizeof(uint16_t) + sizeof(uint32_t), "Vertex must not contain padding");
 
-    VmaAllocationCreateInfo allocInfo = {};
-    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    std::unordered_map<std::string_view, uint32_t> lookup;
+    lookup.reserve(triangleList.size());
+    vertices.clear();
+    vertices.reserve(triangleList.size());
+    indices.clear();
+    indices.reserve(triangleList.size());
 
-    if (vmaCreateBuffer(context->getAllocator(), &bufferInfo, &allocInfo, &vertexBuffer.buffer, &vertexBuffer.allocation, nullptr) != VK_SUCCESS) {
-        throw std::runtime_error("Falha ao criar Vertex Buffer!");
+    for (const auto& vertex : triangleList) {
+        std::string_view key(reinterpret_cast<const char*>(&vertex), sizeof(Vertex));
+        auto [it, inserted] = lookup.try_emplace(key, static_cast<uint32_t>(vertices.size()));
+        if (inserted) vertices.push_back(vertex);
+        indices.push_back(it->second);
     }
+}
+
+void Mesh::createBuffers(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name) {
+    VkDeviceSize vertexSize = sizeof(Vertex) * vertices.size();
+    VkDeviceSize indexSize = sizeof(uint32_t) * indices.size();
+    indexCount = static_cast<uint32_t>(indices.size());
+
+    // Final buffers live in device-local memory; the CPU can't write them directly
+    auto createDeviceBuffer = [&](VkDeviceSize size, VkBufferUsageFlags usage, MeshBuffer& out, const std::string& tag, const char* error) {
+        VkBufferCreateInfo bufferInfo{};
+        bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size = size;
+        bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        VmaAllocationCreateInfo allocInfo = {};
+        allocInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+        if (vmaCreateBuffer(context->getAllocator(), &bufferInfo, &allocInfo, &out.buffer, &out.allocation, nullptr) != VK_SUCCESS) {
+            throw std::runtime_error(error);
+        }
+        context->nameAllocation(out.allocation, tag);
+    };
+    createDeviceBuffer(vertexSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertexBuffer, name + " vertices", "Falha ao criar Vertex Buffer!");
+    createDeviceBuffer(indexSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indexBuffer, name + " indices", "Falha ao criar Index Buffer!");
+
+    // One staging buffer holds vertices then indices for a single transfer
+    VkBufferCreateInfo stagingInfo{};
+    stagingInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    stagingInfo.size = vertexSize + indexSize;
+    stagingInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    stagingInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo stagingAllocInfo = {};
+    stagingAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    MeshBuffer staging;
+    VmaAllocationInfo stagingAllocation{};
+    if (vmaCreateBuffer(context->getAllocator(), &stagingInfo, &stagingAllocInfo, &staging.buffer, &staging.allocation, &stagingAllocation) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar Staging Buffer!");
+    }
+    context->nameAllocation(staging.allocation, "Staging");
+
+    char* data = static_cast<char*>(stagingAllocation.pMappedData);
+    memcpy(data, vertices.data(), (size_t)vertexSize);
+    memcpy(data + vertexSize, indices.data(), (size_t)indexSize);
+    vmaFlushAllocation(context->getAllocator(), staging.allocation, 0, VK_WHOLE_SIZE);
+
+    context->immediateSubmit([&](VkCommandBuffer commandBuffer) {
+        VkBufferCopy vertexCopy{0, 0, vertexSize};
+        vkCmdCopyBuffer(commandBuffer, staging.buffer, vertexBuffer.buffer, 1, &vertexCopy);
+        VkBufferCopy indexCopy{vertexSize, 0, indexSize};
+        vkCmdCopyBuffer(commandBuffer, staging.buffer, indexBuffer.buffer, 1, &indexCopy);
+
+        // Make the copies visible to vertex input in later submissions
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    });
 
-    void* data;
-    vmaMapMemory(context->getAllocator(), vertexBuffer.allocation, &data);
-    memcpy(data, vertices.data(), (size_t)bufferSize);
-    vmaUnmapMemory(context->getAllocator(), vertexBuffer.allocation);
+    vmaDestroyBuffer(context->getAllocator(), staging.buffer, staging.allocation);
 }
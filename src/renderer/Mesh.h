@@ -1,13 +1,28 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <glm/glm.hpp>
 #include <vulkan/vulkan.h>
 #include <vk_mem_alloc.h>
 
+// Packed vertex (12 bytes): half-float position and an octahedral-encoded unit
+// normal in two 16-bit snorms. Color is per instance, not per vertex.
 struct Vertex {
+    uint16_t position[4]; // x, y, z, padding (half floats)
+    uint32_t normal;      // Octahedral x, y as snorm16
+
+    static Vertex make(const glm::vec3& position, const glm::vec3& normal);
+
+    static VkVertexInputBindingDescription getBindingDescription();
+    static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+};
+
+// Per-instance data (binding 1): the unit mesh is scaled, then moved to position.
+struct InstanceData {
     glm::vec3 position;
-    glm::vec3 normal;
+    glm::vec3 scale;
     glm::vec3 color;
 
     static VkVertexInputBindingDescription getBindingDescription();
@@ -23,16 +38,29 @@ public:
         VmaAllocation allocation;
     };
 
-    Mesh(VulkanContext* context, const std::vector<Vertex>& vertices);
+    // Triangle list; identical vertices are merged and drawn through an index buffer
+    // name tags the buffers in the memory statistics
+    Mesh(VulkanContext* context, const std::vector<Vertex>& vertices, const char* name = "Mesh");
+    Mesh(VulkanContext* context, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const char* name = "Mesh");
     ~Mesh();
 
     void bind(VkCommandBuffer commandBuffer);
-    void draw(VkCommandBuffer commandBuffer);
+    void draw(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+    // Draws indexCount indices starting at firstIndex (one section of a baked mesh)
+    void drawRange(VkCommandBuffer commandBuffer, uint32_t firstIndex, uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+    // drawCount VkDrawIndexedIndirectCommands read from indirectBuffer at offset, written by the GPU
+    void drawIndirect(VkCommandBuffer commandBuffer, VkBuffer indirectBuffer, VkDeviceSize offset = 0, uint32_t drawCount = 1);
+
+    uint32_t getIndexCount() const { return indexCount; }
+
+    // Splits a triangle list into unique vertices plus indices
+    static void deduplicate(const std::vector<Vertex>& triangleList, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
 
 private:
-    void createVertexBuffer(const std::vector<Vertex>& vertices);
+    void createBuffers(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name);
 
     VulkanContext* context;
     MeshBuffer vertexBuffer;
-    uint32_t vertexCount;
+    MeshBuffer indexBuffer;
+    uint32_t indexCount;
 };
@@ -0,0 +1,94 @@
+#include "OffscreenTarget.h"
+#include "VulkanContext.h"
+#include <cstring>
+#include <stdexcept>
+
+OffscreenTarget::OffscreenTarget(VulkanContext* ctx, uint32_t width, uint32_t height, uint32_t imageCount)
+    : context(ctx), extent{width, height}, colors(imageCount), framebuffers(imageCount, VK_NULL_HANDLE) {
+    renderPass = createRenderPass(context->getDevice(), COLOR_FORMAT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    depth = createAttachmentImage(context, extent, DEPTH_FORMAT,
+                                  VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_IMAGE_ASPECT_DEPTH_BIT, "Depth");
+
+    for (uint32_t i = 0; i < imageCount; i++) {
+        colors[i] = createAttachmentImage(context, extent, COLOR_FORMAT,
+                                          VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, VK_IMAGE_ASPECT_COLOR_BIT,
+                                          "Offscreen color");
+
+        VkImageView attachments[] = {colors[i].view, depth.view};
+
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPass;
+        framebufferInfo.attachmentCount = 2;
+        framebufferInfo.pAttachments = attachments;
+        framebufferInfo.width = extent.width;
+        framebufferInfo.height = extent.height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(context->getDevice(), &framebufferInfo, nullptr, &framebuffers[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar Framebuffer offscreen!");
+        }
+    }
+}
+
+OffscreenTarget::~OffscreenTarget() {
+    for (auto framebuffer : framebuffers) {
+        vkDestroyFramebuffer(context->getDevice(), framebuffer, nullptr);
+    }
+    for (auto& color : colors) {
+        destroyAttachmentImage(context, color);
+    }
+    destroyAttachmentImage(context, depth);
+    vkDestroyRenderPass(context->getDevice(), renderPass, nullptr);
+}
+
+void OffscreenTarget::readback(uint32_t imageIndex, std::vector<uint8_t>& rgba) {
+    VkDeviceSize size = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo allocInfo = {};
+    allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+    allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VkBuffer buffer;
+    VmaAllocation allocation;
+    VmaAllocationInfo allocationInfo{};
+    if (vmaCreateBuffer(context->getAllocator(), &bufferInfo, &allocInfo, &buffer, &allocation, &allocationInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao criar buffer de readback!");
+    }
+    context->nameAllocation(allocation, "Readback");
+
+    context->immediateSubmit([&](VkCommandBuffer commandBuffer) {
+        // The render pass already left the image in TRANSFER_SRC_OPTIMAL; only the writes need ordering
+        VkMemoryBarrier renderBarrier{};
+        renderBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        renderBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        renderBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &renderBarrier, 0, nullptr, 0, nullptr);
+
+        VkBufferImageCopy region{};
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageExtent = {extent.width, extent.height, 1};
+        vkCmdCopyImageToBuffer(commandBuffer, colors[imageIndex].image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer, 1, &region);
+
+        VkMemoryBarrier hostBarrier{};
+        hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                             0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+    });
+
+    vmaInvalidateAllocation(context->getAllocator(), allocation, 0, VK_WHOLE_SIZE); // No-op on coherent memory
+    rgba.resize(static_cast<size_t>(size));
+    memcpy(rgba.data(), allocationInfo.pMappedData, rgba.size());
+
+    vmaDestroyBuffer(context->getAllocator(), buffer, allocation);
+}
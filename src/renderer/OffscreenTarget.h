@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "RenderTarget.h"
+
+// Color and depth images in VMA memory instead of a swapchain: needs no window
+// or surface, so it runs on machines without a display or GPU (e.g. lavapipe).
+// Holds one color image per frame in flight so frames never share one; each
+// frame leaves its image in TRANSFER_SRC_OPTIMAL, ready to be read back.
+class OffscreenTarget : public RenderTarget {
+public:
+    static constexpr VkFormat COLOR_FORMAT = VK_FORMAT_R8G8B8A8_SRGB; // Same encoding as the swapchain
+
+    OffscreenTarget(VulkanContext* context, uint32_t width, uint32_t height, uint32_t imageCount);
+    ~OffscreenTarget() override;
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+
+    VkRenderPass getRenderPass() const override { return renderPass; }
+    const std::vector<VkFramebuffer>& getFramebuffers() const override { return framebuffers; }
+    VkExtent2D getExtent() const override { return extent; }
+
+    // Copies a rendered image to rgba (8 bits per channel, rows top to bottom).
+    // Blocks until the copy is done; the image must have been rendered at least once.
+    void readback(uint32_t imageIndex, std::vector<uint8_t>& rgba);
+
+private:
+    VulkanContext* context;
+    VkExtent2D extent;
+    VkRenderPass renderPass{VK_NULL_HANDLE};
+    std::vector<AttachmentImage> colors;
+    AttachmentImage depth; // Shared by every image
+    std::vector<VkFramebuffer> framebuffers;
+};
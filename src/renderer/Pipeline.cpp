@@ -31,14 +31,10 @@ Pipeline::Pipeline(VulkanContext* ctx, const std::string& vertPath, const std::s
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     
-    // Setup Vertex Input from Mesh definitions
-    auto bindingDescription = Vertex::getBindingDescription();
-    auto attributeDescriptions = Vertex::getAttributeDescriptions();
-
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(configInfo.bindingDescriptions.size());
+    vertexInputInfo.pVertexBindingDescriptions = configInfo.bindingDescriptions.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(configInfo.attributeDescriptions.size());
+    vertexInputInfo.pVertexAttributeDescriptions = configInfo.attributeDescriptions.data();
 
     VkPipelineViewportStateCreateInfo viewportInfo{};
     viewportInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -70,7 +66,7 @@ Pipeline::Pipeline(VulkanContext* ctx, const std::string& vertPath, const std::s
     
     this->pipelineLayout = configInfo.pipelineLayout;
 
-    if (vkCreateGraphicsPipelines(context->getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(context->getDevice(), context->getPipelineCache(), 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("Falha ao criar pipeline gráfico!");
     }
 }
@@ -86,6 +82,12 @@ void Pipeline::bind(VkCommandBuffer commandBuffer) {
 }
 
 void Pipeline::defaultPipelineConfigInfo(PipelineConfigInfo& configInfo) {
+    // Vertex Input from Mesh definitions: per-vertex data plus per-instance transforms
+    configInfo.bindingDescriptions = {Vertex::getBindingDescription(), InstanceData::getBindingDescription()};
+    configInfo.attributeDescriptions = Vertex::getAttributeDescriptions();
+    auto instanceAttributes = InstanceData::getAttributeDescriptions();
+    configInfo.attributeDescriptions.insert(configInfo.attributeDescriptions.end(), instanceAttributes.begin(), instanceAttributes.end());
+
     configInfo.inputAssemblyInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
     configInfo.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     configInfo.inputAssemblyInfo.primitiveRestartEnable = VK_FALSE;
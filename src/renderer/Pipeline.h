@@ -7,6 +7,8 @@
 class VulkanContext;
 
 struct PipelineConfigInfo {
+    std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
     VkPipelineInputAssemblyStateCreateInfo inputAssemblyInfo;
     VkPipelineRasterizationStateCreateInfo rasterizationInfo;
     VkPipelineMultisampleStateCreateInfo multisampleInfo;
@@ -30,10 +32,11 @@ public:
     static void defaultPipelineConfigInfo(PipelineConfigInfo& configInfo);
 
     VkPipelineLayout getPipelineLayout() const { return pipelineLayout; }
+
+    static std::vector<char> readFile(const std::string& filepath);
     
 private:
     VkShaderModule createShaderModule(const std::vector<char>& code);
-    static std::vector<char> readFile(const std::string& filepath);
 
     VulkanContext* context;
     VkPipeline graphicsPipeline;
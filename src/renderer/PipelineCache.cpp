@@ -0,0 +1,103 @@
+#include "PipelineCache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+PipelineCache::PipelineCache(VkPhysicalDevice physicalDevice, VkDevice logicalDevice, std::string cachePath)
+    : device(logicalDevice), path(std::move(cachePath)) {
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    std::vector<char> data;
+    std::ifstream file(path, std::ios::binary);
+    if (file.is_open()) {
+        // Bytes after the header; a truncated or corrupted file must not size the allocation
+        std::error_code sizeError;
+        uint64_t fileSize = std::filesystem::file_size(path, sizeError);
+        uint64_t payloadSize = !sizeError && fileSize >= sizeof(FileHeader) ? fileSize - sizeof(FileHeader) : 0;
+
+        FileHeader header{};
+        FileHeader expected = expectedHeader();
+        if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+            header.magic == expected.magic && header.version == expected.version &&
+            header.vendorID == expected.vendorID && header.deviceID == expected.deviceID &&
+            header.driverVersion == expected.driverVersion &&
+            std::memcmp(header.pipelineCacheUUID, expected.pipelineCacheUUID, VK_UUID_SIZE) == 0 &&
+            header.dataSize == payloadSize) {
+            data.resize(static_cast<size_t>(header.dataSize));
+            if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) data.clear();
+        }
+        if (data.empty()) {
+            std::cerr << "Pipeline cache ignorado (outro dispositivo/driver ou arquivo corrompido): " << path << "\n";
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = data.size();
+    cacheInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(device, &cacheInfo, nullptr, &cache) != VK_SUCCESS) {
+        // The driver may still reject data that passed our checks; start empty
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        if (vkCreatePipelineCache(device, &cacheInfo, nullptr, &cache) != VK_SUCCESS) {
+            std::cerr << "Falha ao criar pipeline cache\n";
+            cache = VK_NULL_HANDLE;
+        }
+    } else if (!data.empty()) {
+        std::cout << "Pipeline cache carregado: " << data.size() << " bytes\n";
+    }
+}
+
+PipelineCache::~PipelineCache() {
+    if (cache == VK_NULL_HANDLE) return;
+    save();
+    vkDestroyPipelineCache(device, cache, nullptr);
+}
+
+PipelineCache::FileHeader PipelineCache::expectedHeader() const {
+    FileHeader header{};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    return header;
+}
+
+void PipelineCache::save() {
+    if (cache == VK_NULL_HANDLE) return;
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0) return;
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) {
+        std::cerr << "Falha ao ler dados do pipeline cache\n";
+        return;
+    }
+
+    FileHeader header = expectedHeader();
+    header.dataSize = size;
+
+    // Write to a temporary file and rename it, so a crash never leaves a truncated cache
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() ||
+            !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(data.data(), static_cast<std::streamsize>(size))) {
+            std::cerr << "Falha ao salvar pipeline cache: " << tempPath << "\n";
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::cerr << "Falha ao salvar pipeline cache: " << error.message() << "\n";
+    }
+}
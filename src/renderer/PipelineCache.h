@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vulkan/vulkan.h>
+
+// VkPipelineCache persisted to disk between runs, so pipelines compiled on a
+// previous launch are reused. The file is only accepted when it was written by
+// the same device and driver (vendor, device ID, driver version, cache UUID);
+// otherwise it is ignored and rebuilt. Saved on destruction.
+class PipelineCache {
+public:
+    PipelineCache(VkPhysicalDevice physicalDevice, VkDevice device, std::string path);
+    ~PipelineCache();
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    // Internally synchronized: safe to use from several threads at once
+    VkPipelineCache getCache() const { return cache; }
+
+    void save();
+
+private:
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint32_t driverVersion;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+        uint64_t dataSize;
+    };
+
+    static constexpr uint32_t MAGIC = 0x43503350; // "P3PC"
+    static constexpr uint32_t VERSION = 1;
+
+    FileHeader expectedHeader() const;
+
+    VkDevice device;
+    VkPhysicalDeviceProperties properties{};
+    std::string path;
+    VkPipelineCache cache{VK_NULL_HANDLE};
+};
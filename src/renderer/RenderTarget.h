@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+class VulkanContext;
+
+// Where frames are rendered: the window's swapchain or offscreen images.
+// One framebuffer per image, all sharing the render pass (color + depth) and extent.
+class RenderTarget {
+public:
+    static constexpr VkFormat DEPTH_FORMAT = VK_FORMAT_D32_SFLOAT; // Simplificado, idealmente checaríamos suporte
+
+    virtual ~RenderTarget() = default;
+
+    virtual VkRenderPass getRenderPass() const = 0;
+    virtual const std::vector<VkFramebuffer>& getFramebuffers() const = 0;
+    virtual VkExtent2D getExtent() const = 0;
+
+protected:
+    // Image with its memory and a view of the whole image
+    struct AttachmentImage {
+        VkImage image{VK_NULL_HANDLE};
+        VmaAllocation allocation{VK_NULL_HANDLE};
+        VkImageView view{VK_NULL_HANDLE};
+    };
+
+    // Clears color and depth; the color attachment ends in colorFinalLayout
+    static VkRenderPass createRenderPass(VkDevice device, VkFormat colorFormat, VkImageLayout colorFinalLayout);
+    // name tags the allocation in the memory statistics
+    static AttachmentImage createAttachmentImage(VulkanContext* context, VkExtent2D extent, VkFormat format,
+                                                 VkImageUsageFlags usage, VkImageAspectFlags aspect, const char* name);
+    static void destroyAttachmentImage(VulkanContext* context, AttachmentImage& attachment);
+};
@@ -0,0 +1,77 @@
+#include "SecondaryRecorder.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+
+SecondaryRecorder::SecondaryRecorder(VulkanContext* ctx, uint32_t slotCount, unsigned threads)
+    : context(ctx), threadCount(threads), pools(slotCount * threads) {
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    // No flags: buffers are only reset along with their whole pool
+    poolInfo.queueFamilyIndex = context->getGraphicsQueueFamily();
+
+    for (auto& threadPool : pools) {
+        if (vkCreateCommandPool(context->getDevice(), &poolInfo, nullptr, &threadPool.pool) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao criar command pool secundario!");
+        }
+    }
+}
+
+SecondaryRecorder::~SecondaryRecorder() {
+    // Destroying a pool frees its command buffers
+    for (auto& threadPool : pools) {
+        vkDestroyCommandPool(context->getDevice(), threadPool.pool, nullptr);
+    }
+}
+
+SecondaryRecorder::ThreadPool& SecondaryRecorder::threadPool(uint32_t slot, unsigned threadIndex) {
+    return pools[slot * threadCount + threadIndex];
+}
+
+void SecondaryRecorder::reset(uint32_t slot) {
+    for (unsigned i = 0; i < threadCount; i++) {
+        ThreadPool& current = threadPool(slot, i);
+        if (current.used == 0) continue;
+        vkResetCommandPool(context->getDevice(), current.pool, 0);
+        current.used = 0;
+    }
+}
+
+VkCommandBuffer SecondaryRecorder::begin(uint32_t slot, unsigned threadIndex, VkRenderPass renderPass, VkFramebuffer framebuffer) {
+    ThreadPool& current = threadPool(slot, threadIndex);
+    if (current.used == current.buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = current.pool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        if (vkAllocateCommandBuffers(context->getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Falha ao alocar command buffer secundario!");
+        }
+        current.buffers.push_back(commandBuffer);
+    }
+    VkCommandBuffer commandBuffer = current.buffers[current.used++];
+
+    VkCommandBufferInheritanceInfo inheritance{};
+    inheritance.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance.renderPass = renderPass;
+    inheritance.subpass = 0;
+    inheritance.framebuffer = framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT; // May be submitted again while cached
+    beginInfo.pInheritanceInfo = &inheritance;
+
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao iniciar gravacao do command buffer secundario!");
+    }
+    return commandBuffer;
+}
+
+void SecondaryRecorder::end(VkCommandBuffer commandBuffer) {
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Falha ao finalizar gravacao do command buffer secundario!");
+    }
+}
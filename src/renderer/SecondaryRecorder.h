@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+class VulkanContext;
+
+// Secondary command buffers recorded in parallel inside one render pass.
+// Every (slot, thread) pair owns a command pool, so JobSystem threads record
+// without locking and a whole slot is recycled with one pool reset. A slot is
+// whatever the owner re-records as a unit (here: one cached primary buffer).
+// Buffers are kept and reused from one recording to the next.
+class SecondaryRecorder {
+public:
+    SecondaryRecorder(VulkanContext* context, uint32_t slotCount, unsigned threadCount);
+    ~SecondaryRecorder();
+
+    SecondaryRecorder(const SecondaryRecorder&) = delete;
+    SecondaryRecorder& operator=(const SecondaryRecorder&) = delete;
+
+    // Resets every pool of the slot; the GPU must be done with its last submission
+    void reset(uint32_t slot);
+
+    // Returns a secondary buffer, already begun to continue renderPass/framebuffer.
+    // Only thread threadIndex may call this for a given slot at a time.
+    VkCommandBuffer begin(uint32_t slot, unsigned threadIndex, VkRenderPass renderPass, VkFramebuffer framebuffer);
+
+    // Ends a buffer returned by begin
+    static void end(VkCommandBuffer commandBuffer);
+
+private:
+    struct ThreadPool {
+        VkCommandPool pool{VK_NULL_HANDLE};
+        std::vector<VkCommandBuffer> buffers; // Allocated so far, reused after a reset
+        size_t used{0};
+    };
+
+    ThreadPool& threadPool(uint32_t slot, unsigned threadIndex);
+
+    VulkanContext* context;
+    unsigned threadCount;
+    std::vector<ThreadPool> pools; // slot * threadCount + threadIndex
+};
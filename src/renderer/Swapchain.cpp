@@ -1,17 +1,52 @@
 #include "Swapchain.h"
 #include "VulkanContext.h"
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+
+namespace {
+    const char* presentModeName(VkPresentModeKHR mode) {
+        switch (mode) {
+            case VK_PRESENT_MODE_IMMEDIATE_KHR: return "IMMEDIATE";
+            case VK_PRESENT_MODE_MAILBOX_KHR: return "MAILBOX";
+            case VK_PRESENT_MODE_FIFO_KHR: return "FIFO";
+            case VK_PRESENT_MODE_FIFO_RELAXED_KHR: return "FIFO_RELAXED";
+            default: return "?";
+        }
+    }
+}
 
-void Swapchain::init(VulkanContext* ctx, uint32_t width, uint32_t height) {
+void Swapchain::init(VulkanContext* ctx, uint32_t width, uint32_t height, VkPresentModeKHR desired) {
     context = ctx;
+    desiredPresentMode = desired;
+    presentMode = selectPresentMode();
+    if (presentMode != desiredPresentMode) {
+        std::cerr << "Present mode " << presentModeName(desiredPresentMode) << " nao suportado, usando "
+                  << presentModeName(presentMode) << "\n";
+    }
     createSwapchain(width, height);
     createImageViews();
-    createRenderPass();
+    renderPass = createRenderPass(context->getDevice(), swapchain.image_format, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
     createDepthResources();
     createFramebuffers();
 }
 
 void Swapchain::cleanup() {
+    destroySizedResources();
+    vkDestroyRenderPass(context->getDevice(), renderPass, nullptr);
+    renderPass = VK_NULL_HANDLE;
+    vkb::destroy_swapchain(swapchain);
+}
+
+void Swapchain::recreate(uint32_t width, uint32_t height) {
+    destroySizedResources();
+    createSwapchain(width, height); // Hands the old swapchain over, then destroys it
+    createImageViews();
+    createDepthResources();
+    createFramebuffers();
+}
+
+void Swapchain::destroySizedResources() {
     VkDevice device = context->getDevice();
 
     for (auto framebuffer : framebuffers) {
@@ -19,17 +54,12 @@ void Swapchain::cleanup() {
     }
     framebuffers.clear();
 
-    vkDestroyRenderPass(device, renderPass, nullptr);
-
-    vkDestroyImageView(device, depthImageView, nullptr);
-    vmaDestroyImage(context->getAllocator(), depthImage, depthImageAllocation);
+    destroyAttachmentImage(context, depth);
 
     for (auto imageView : imageViews) {
         vkDestroyImageView(device, imageView, nullptr);
     }
     imageViews.clear();
-
-    vkb::destroy_swapchain(swapchain);
 }
 
 void Swapchain::createSwapchain(uint32_t width, uint32_t height) {
@@ -38,131 +68,52 @@ void Swapchain::createSwapchain(uint32_t width, uint32_t height) {
     // Usamos VK_FORMAT_B8G8R8A8_SRGB para o formato de cor padrão
     auto vkbSwapchainRet = swapchainBuilder
         .use_default_format_selection()
-        .set_desired_present_mode(VK_PRESENT_MODE_FIFO_KHR) // GPU e Monitor sincronizados (V-Sync)
+        .set_desired_present_mode(presentMode) // Already known to be supported
         .set_desired_extent(width, height)
+        .set_old_swapchain(swapchain) // VK_NULL_HANDLE on the first build
         .build();
 
+    // Also runs on every recreate: keeping the old swapchain would only bring OUT_OF_DATE back
     if (!vkbSwapchainRet) {
-        std::cerr << "Falha ao criar Swapchain: " << vkbSwapchainRet.error().message() << "\n";
-        return;
+        throw std::runtime_error("Falha ao criar Swapchain: " + vkbSwapchainRet.error().message());
     }
 
+    // The old swapchain is retired once the new one exists; its images are no longer in use
+    vkb::destroy_swapchain(swapchain);
     swapchain = vkbSwapchainRet.value();
 }
 
+VkPresentModeKHR Swapchain::selectPresentMode() const {
+    uint32_t count = 0;
+    vkGetPhysicalDeviceSurfacePresentModesKHR(context->getPhysicalDevice(), context->getSurface(), &count, nullptr);
+    std::vector<VkPresentModeKHR> supported(count);
+    vkGetPhysicalDeviceSurfacePresentModesKHR(context->getPhysicalDevice(), context->getSurface(), &count, supported.data());
+    auto isSupported = [&](VkPresentModeKHR mode) {
+        return std::find(supported.begin(), supported.end(), mode) != supported.end();
+    };
+
+    // Uncapped modes fall back to each other before giving up on them: IMMEDIATE tears
+    // but has the least latency, MAILBOX never tears but may drop frames.
+    // FIFO (V-Sync) is the only mode every implementation supports.
+    std::vector<VkPresentModeKHR> preferences{desiredPresentMode};
+    if (desiredPresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) preferences.push_back(VK_PRESENT_MODE_MAILBOX_KHR);
+    if (desiredPresentMode == VK_PRESENT_MODE_MAILBOX_KHR) preferences.push_back(VK_PRESENT_MODE_IMMEDIATE_KHR);
+
+    for (auto mode : preferences) {
+        if (isSupported(mode)) return mode;
+    }
+    return VK_PRESENT_MODE_FIFO_KHR;
+}
+
 void Swapchain::createImageViews() {
     auto images = swapchain.get_images().value();
     auto views = swapchain.get_image_views().value();
     imageViews = views;
 }
 
-void Swapchain::createRenderPass() {
-    // 1. Color Attachment
-    VkAttachmentDescription colorAttachment{};
-    colorAttachment.format = swapchain.image_format;
-    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-    VkAttachmentReference colorAttachmentRef{};
-    colorAttachmentRef.attachment = 0;
-    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-    // 2. Depth Attachment
-    depthFormat = VK_FORMAT_D32_SFLOAT; // Simplificado, idealmente checaríamos suporte
-    VkAttachmentDescription depthAttachment{};
-    depthAttachment.format = depthFormat;
-    depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-    VkAttachmentReference depthAttachmentRef{};
-    depthAttachmentRef.attachment = 1;
-    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-    // Subpass
-    VkSubpassDescription subpass{};
-    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-    subpass.colorAttachmentCount = 1;
-    subpass.pColorAttachments = &colorAttachmentRef;
-    subpass.pDepthStencilAttachment = &depthAttachmentRef;
-
-    // Dependencies
-    VkSubpassDependency dependency{};
-    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependency.dstSubpass = 0;
-    dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    dependency.srcAccessMask = 0;
-    dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-
-    std::vector<VkAttachmentDescription> attachments = {colorAttachment, depthAttachment};
-
-    VkRenderPassCreateInfo renderPassInfo{};
-    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-    renderPassInfo.pAttachments = attachments.data();
-    renderPassInfo.subpassCount = 1;
-    renderPassInfo.pSubpasses = &subpass;
-    renderPassInfo.dependencyCount = 1;
-    renderPassInfo.pDependencies = &dependency;
-
-    if (vkCreateRenderPass(context->getDevice(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
-        std::cerr << "Falha ao criar Render Pass\n";
-    }
-}
-
 void Swapchain::createDepthResources() {
-    VkExtent3D depthImageExtent = {
-        swapchain.extent.width,
-        swapchain.extent.height,
-        1
-    };
-
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent = depthImageExtent;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = depthFormat;
-    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    VmaAllocationCreateInfo dimgAllocInfo = {};
-    dimgAllocInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    
-    // NOTA: Usando contexto->getAllocator() que precisa ser público ou getter. 
-    // Assumindo que criaremos o getter ou usaremos Vma puro com device por enquanto?
-    // O VulkanContext já tem getAllocator().
-    
-    vmaCreateImage(context->getAllocator(), &imageInfo, &dimgAllocInfo, &depthImage, &depthImageAllocation, nullptr);
-
-    VkImageViewCreateInfo viewInfo{};
-    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-    viewInfo.image = depthImage;
-    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-    viewInfo.format = depthFormat;
-    viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-    viewInfo.subresourceRange.baseMipLevel = 0;
-    viewInfo.subresourceRange.levelCount = 1;
-    viewInfo.subresourceRange.baseArrayLayer = 0;
-    viewInfo.subresourceRange.layerCount = 1;
-
-    if (vkCreateImageView(context->getDevice(), &viewInfo, nullptr, &depthImageView) != VK_SUCCESS) {
-        std::cerr << "Falha ao criar Depth Image View\n";
-    }
+    depth = createAttachmentImage(context, swapchain.extent, DEPTH_FORMAT,
+                                  VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_IMAGE_ASPECT_DEPTH_BIT, "Depth");
 }
 
 void Swapchain::createFramebuffers() {
@@ -171,7 +122,7 @@ void Swapchain::createFramebuffers() {
     for (size_t i = 0; i < imageViews.size(); i++) {
         std::vector<VkImageView> attachments = {
             imageViews[i],
-            depthImageView
+            depth.view
         };
 
         VkFramebufferCreateInfo framebufferInfo{};
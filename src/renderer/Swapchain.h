@@ -3,39 +3,46 @@
 #include <vulkan/vulkan.h>
 #include <VkBootstrap.h>
 #include <vector>
-#include <vk_mem_alloc.h> // Added include
+#include "RenderTarget.h"
 
 class VulkanContext;
 
-class Swapchain {
+class Swapchain : public RenderTarget {
 public:
     Swapchain() = default;
-    ~Swapchain() = default;
+    ~Swapchain() override = default;
 
-    void init(VulkanContext* context, uint32_t width, uint32_t height);
+    // presentMode is a preference: falls back to another supported mode (FIFO always is)
+    void init(VulkanContext* context, uint32_t width, uint32_t height, VkPresentModeKHR presentMode = VK_PRESENT_MODE_FIFO_KHR);
     void cleanup();
 
+    // Rebuilds the swapchain and everything sized by it for a new window size.
+    // The render pass is kept, so pipelines built against it stay valid.
+    // The caller must make sure the GPU no longer uses the old images.
+    void recreate(uint32_t width, uint32_t height);
+
     vkb::Swapchain getSwapchain() const { return swapchain; }
-    VkRenderPass getRenderPass() const { return renderPass; }
-    const std::vector<VkFramebuffer>& getFramebuffers() const { return framebuffers; }
-    VkExtent2D getExtent() const { return swapchain.extent; }
+    VkRenderPass getRenderPass() const override { return renderPass; }
+    const std::vector<VkFramebuffer>& getFramebuffers() const override { return framebuffers; }
+    VkExtent2D getExtent() const override { return swapchain.extent; }
+    VkPresentModeKHR getPresentMode() const { return presentMode; }
 
 private:
     void createSwapchain(uint32_t width, uint32_t height);
+    VkPresentModeKHR selectPresentMode() const;
+    void destroySizedResources();
     void createImageViews();
-    void createRenderPass();
     void createDepthResources();
     void createFramebuffers();
 
     VulkanContext* context{nullptr};
     vkb::Swapchain swapchain;
+    VkPresentModeKHR desiredPresentMode{VK_PRESENT_MODE_FIFO_KHR};
+    VkPresentModeKHR presentMode{VK_PRESENT_MODE_FIFO_KHR};
     std::vector<VkImageView> imageViews;
     std::vector<VkFramebuffer> framebuffers;
 
-    VkImage depthImage{VK_NULL_HANDLE};
-    VmaAllocation depthImageAllocation; // Replaced VkDeviceMemory with VmaAllocation
-    VkImageView depthImageView{VK_NULL_HANDLE};
-    VkFormat depthFormat{VK_FORMAT_UNDEFINED};
+    AttachmentImage depth; // Shared by every image
 
     VkRenderPass renderPass{VK_NULL_HANDLE};
 };
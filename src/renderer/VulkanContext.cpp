@@ -1,13 +1,38 @@
 #include <GLFW/glfw3.h>
 #include "VulkanContext.h"
+#include "PipelineCache.h"
+#include "MemoryBudget.h"
+#include <cstring>
 #include <iostream>
+#include <vector>
+
+namespace {
+    const char* PIPELINE_CACHE_PATH = "pipeline_cache.bin";
+
+    bool hasDeviceExtension(VkPhysicalDevice physicalDevice, const char* name) {
+        uint32_t count = 0;
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, nullptr);
+        std::vector<VkExtensionProperties> extensions(count);
+        vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &count, extensions.data());
+        for (const auto& extension : extensions) {
+            if (std::strcmp(extension.extensionName, name) == 0) return true;
+        }
+        return false;
+    }
+}
+
+VulkanContext::VulkanContext() = default;
+VulkanContext::~VulkanContext() = default;
 
 void VulkanContext::init(GLFWwindow* window, const char* appName) {
+    bool headless = window == nullptr;
+
     vkb::InstanceBuilder builder;
     auto inst_ret = builder.set_app_name(appName)
         .request_validation_layers(true)
         .require_api_version(1, 3, 0)
         .use_default_debug_messenger()
+        .set_headless(headless) // No surface extensions needed
         .build();
 
     if (!inst_ret) {
@@ -16,21 +41,46 @@ void VulkanContext::init(GLFWwindow* window, const char* appName) {
     }
     instance = inst_ret.value();
 
-    if (glfwCreateWindowSurface(instance.instance, window, nullptr, &surface) != VK_SUCCESS) {
+    if (!headless && glfwCreateWindowSurface(instance.instance, window, nullptr, &surface) != VK_SUCCESS) {
         std::cerr << "Falha ao criar Window Surface\n";
         return;
     }
 
-    vkb::PhysicalDeviceSelector selector{instance};
-    auto phys_ret = selector.set_surface(surface)
-        .set_minimum_version(1, 3)
-        .select();
+    // Without a surface any device will do, software ones (lavapipe) included
+    auto selectDevice = [&](const VkPhysicalDeviceFeatures& requiredFeatures) {
+        vkb::PhysicalDeviceSelector selector{instance};
+        if (headless) selector.defer_surface_initialization();
+        else selector.set_surface(surface);
+        return selector
+            .set_minimum_version(1, 3)
+            .set_required_features(requiredFeatures)
+            .add_desired_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) // Driver-reported heap budgets
+            .select();
+    };
+
+    // GPU culling wants every level section in one multi-draw indirect call, each draw
+    // picking its instance through firstInstance. Both features are optional: prefer a
+    // device with both, then one with firstInstance only (one indirect draw per batch
+    // of maxDrawIndirectCount), then any device (CPU culling only).
+    VkPhysicalDeviceFeatures indirectFeatures{};
+    indirectFeatures.multiDrawIndirect = VK_TRUE;
+    indirectFeatures.drawIndirectFirstInstance = VK_TRUE;
+    auto phys_ret = selectDevice(indirectFeatures);
+    if (!phys_ret) {
+        indirectFeatures.multiDrawIndirect = VK_FALSE;
+        phys_ret = selectDevice(indirectFeatures);
+    }
+    if (!phys_ret) {
+        indirectFeatures.drawIndirectFirstInstance = VK_FALSE;
+        phys_ret = selectDevice(indirectFeatures);
+    }
 
     if (!phys_ret) {
         std::cerr << "Falha ao selecionar Physical Device: " << phys_ret.error().message() << "\n";
         return;
     }
     physicalDevice = phys_ret.value();
+    drawIndirectFirstInstance = indirectFeatures.drawIndirectFirstInstance == VK_TRUE;
 
     vkb::DeviceBuilder deviceBuilder{physicalDevice};
     auto dev_ret = deviceBuilder.build();
@@ -41,7 +91,7 @@ void VulkanContext::init(GLFWwindow* window, const char* appName) {
     device = dev_ret.value();
 
     graphicsQueue = device.get_queue(vkb::QueueType::graphics).value();
-    presentQueue = device.get_queue(vkb::QueueType::present).value();
+    if (!headless) presentQueue = device.get_queue(vkb::QueueType::present).value();
 
     VkCommandPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
@@ -58,19 +108,88 @@ void VulkanContext::init(GLFWwindow* window, const char* appName) {
     allocatorInfo.device = device.device;
     allocatorInfo.instance = instance.instance;
     allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_3;
-    
-    vmaCreateAllocator(&allocatorInfo, &allocator);
+
+    // Desired extensions are enabled whenever the device has them
+    bool driverBudget = hasDeviceExtension(physicalDevice.physical_device, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    if (driverBudget) allocatorInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+
+    if (vmaCreateAllocator(&allocatorInfo, &allocator) != VK_SUCCESS) {
+        std::cerr << "Falha ao criar VMA Allocator\n";
+        return;
+    }
+    memoryBudget = std::make_unique<MemoryBudget>(allocator, driverBudget);
+    if (!driverBudget) {
+        std::cout << "VK_EXT_memory_budget indisponivel; orcamento de memoria estimado pelo VMA\n";
+    }
+
+    pipelineCache = std::make_unique<PipelineCache>(physicalDevice.physical_device, device.device, PIPELINE_CACHE_PATH);
 
     std::cout << "Vulkan inicializado com sucesso! GPU: " << physicalDevice.name << "\n";
 }
 
+VkPipelineCache VulkanContext::getPipelineCache() const {
+    return pipelineCache ? pipelineCache->getCache() : VK_NULL_HANDLE;
+}
+
+void VulkanContext::nameAllocation(VmaAllocation allocation, const std::string& name) const {
+    vmaSetAllocationName(allocator, allocation, name.c_str());
+}
+
+void VulkanContext::immediateSubmit(const std::function<void(VkCommandBuffer)>& record) {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.commandPool = commandPool;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(device.device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        std::cerr << "Falha ao alocar command buffer de upload\n";
+        return;
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+    record(commandBuffer);
+    vkEndCommandBuffer(commandBuffer);
+
+    VkFenceCreateInfo fenceInfo{};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    VkFence fence;
+    if (vkCreateFence(device.device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+        std::cerr << "Falha ao criar fence de upload\n";
+        vkFreeCommandBuffers(device.device, commandPool, 1, &commandBuffer);
+        return;
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+
+    if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, fence) != VK_SUCCESS) {
+        std::cerr << "Falha ao submeter upload\n";
+    } else {
+        vkWaitForFences(device.device, 1, &fence, VK_TRUE, UINT64_MAX);
+    }
+
+    vkDestroyFence(device.device, fence, nullptr);
+    vkFreeCommandBuffers(device.device, commandPool, 1, &commandBuffer);
+}
+
 void VulkanContext::cleanup() {
+    pipelineCache.reset(); // Saves the cache to disk
+    memoryBudget.reset();
     if (allocator != VK_NULL_HANDLE) {
         vmaDestroyAllocator(allocator);
     }
     
     vkDestroyCommandPool(device.device, commandPool, nullptr);
     vkb::destroy_device(device);
-    vkDestroySurfaceKHR(instance.instance, surface, nullptr);
+    if (surface != VK_NULL_HANDLE) vkDestroySurfaceKHR(instance.instance, surface, nullptr);
     vkb::destroy_instance(instance);
 }
@@ -1,37 +1,60 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <string>
 #include <vulkan/vulkan.h>
 #include <VkBootstrap.h>
 #include <vk_mem_alloc.h>
 
 struct GLFWwindow;
+class PipelineCache;
+class MemoryBudget;
 
 class VulkanContext {
 public:
-    VulkanContext() = default;
-    ~VulkanContext() = default;
+    VulkanContext();
+    ~VulkanContext();
 
+    // A null window selects headless mode: no surface, swapchain or present queue
+    // (rendering goes to an OffscreenTarget)
     void init(GLFWwindow* window, const char* appName);
     void cleanup();
 
     VkDevice getDevice() const { return device.device; }
     VkPhysicalDevice getPhysicalDevice() const { return physicalDevice.physical_device; }
     VkInstance getInstance() const { return instance.instance; }
-    VkSurfaceKHR getSurface() const { return surface; }
+    VkSurfaceKHR getSurface() const { return surface; } // VK_NULL_HANDLE when headless
     VkQueue getGraphicsQueue() const { return graphicsQueue; }
     VkCommandPool getCommandPool() const { return commandPool; }
     uint32_t getGraphicsQueueFamily() const { return device.get_queue_index(vkb::QueueType::graphics).value(); }
     VmaAllocator getAllocator() const { return allocator; }
+    // Enabled only when the device has it; GPU culling needs it (see GpuCuller)
+    bool hasDrawIndirectFirstInstance() const { return drawIndirectFirstInstance; }
+    // Persistent cache for every pipeline creation (VK_NULL_HANDLE if it couldn't be created)
+    VkPipelineCache getPipelineCache() const;
+    // Heap usage versus budget and the VMA statistics dump
+    MemoryBudget& getMemoryBudget() { return *memoryBudget; }
+
+    // Tags an allocation with the subsystem that owns it (shown in the statistics dump)
+    void nameAllocation(VmaAllocation allocation, const std::string& name) const;
+
+    // Records commands into a one-time command buffer, submits it to the graphics
+    // queue and blocks until the GPU is done (uploads at load time)
+    void immediateSubmit(const std::function<void(VkCommandBuffer)>& record);
 
 private:
     vkb::Instance instance;
     vkb::PhysicalDevice physicalDevice;
     vkb::Device device;
     VkSurfaceKHR surface{VK_NULL_HANDLE};
+    bool drawIndirectFirstInstance{false};
     
     VkQueue graphicsQueue{VK_NULL_HANDLE};
     VkQueue presentQueue{VK_NULL_HANDLE};
 
     VkCommandPool commandPool{VK_NULL_HANDLE};
     VmaAllocator allocator{VK_NULL_HANDLE};
+    std::unique_ptr<PipelineCache> pipelineCache;
+    std::unique_ptr<MemoryBudget> memoryBudget;
 };